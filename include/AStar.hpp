@@ -3,19 +3,21 @@
  * @author Felipe Passarela (feliepassarela11@gmail.com)
  * @brief A* pathfinding algorithm header file.
  * @date 2024-02-14
- * 
+ *
  * @copyright Copyright (c) 2024
- * 
+ *
  */
 
-// TODO: Optimize the A* algorithm by using a priority queue for the open list and a hash set for the closed list.
-
 #ifndef ASTAR_HPP
 #define ASTAR_HPP
 
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <memory>
+#include <utility>
+#include "connectivityIndex.hpp"
+#include "landmarks.hpp"
+#include "pathPolicies.hpp"
 
 /**
  * @namespace AStar
@@ -24,106 +26,144 @@
 namespace AStar
 {
     /**
-     * @struct Node
-     * @brief Represents a node in the A* algorithm.
-     * 
-     * The Node struct represents a node in the A* algorithm. It contains the x and y coordinates of the node, 
-     * the gCost, hCost, and fCost of the node, and a pointer to the parent node.
+     * @struct Stats
+     * @brief What the last search of a Pathfinder cost.
      */
-    struct Node
+    struct Stats
     {
-        int x;
-        int y;
-        double gCost;
-        double hCost;
-        double fCost;
-        std::shared_ptr<Node> parent;
-
-        Node(int x, int y, double gCost, double hCost, std::shared_ptr<Node> parent) :
-             x(x), y(y), gCost(gCost), hCost(hCost), fCost(gCost + hCost), parent(parent) {}
-
-        bool operator==(const Node& other) const { return x == other.x && y == other.y; }
-    }; // struct Node
-
-    using NodePtr = std::shared_ptr<Node>;  // Shared pointer to a Node
-    using NodeList = std::vector<NodePtr>;  // Vector of shared pointers to Nodes
+        std::size_t expandedNodes = 0;  // Nodes taken out of the open list.
+        std::size_t heapPeak = 0;       // The most entries the open list held at once.
+        double milliseconds = 0.0;
+    }; // struct Stats
 
     /**
-     * @namespace Utils
-     * @brief The Utils namespace contains utility functions for the A* pathfinding algorithm.
+     * @class Pathfinder
+     * @brief Finds paths on a map, reusing the same memory for every search.
+     *
+     * The costs, parents and states of all the cells are kept in one array the size of the map, and each
+     * entry is stamped with the search that last wrote it. A new search just increments the stamp, so the
+     * entries of the previous ones read as unvisited without clearing the array, and a search only touches
+     * the cells it visits. The open list is a binary heap that keeps its capacity between searches; entries
+     * made stale by a cheaper path are skipped when popped instead of being searched for.
+     *
+     * The search is a template on the movement and the heuristic (see pathPolicies.hpp), so their steps
+     * and estimates are inlined in the loop, which only adds and compares integer costs. The combinations
+     * that never overestimate are instantiated beforehand, and setPolicy() picks one of them. With landmarks
+     * (see setLandmarks()), the heuristic is the largest of the policy's estimate and their bound. A closed
+     * cell reached by a cheaper path is opened again, in case the two disagree.
+     *
+     * A Pathfinder isn't thread-safe: use one per thread.
      */
-    namespace Utils
+    class Pathfinder
     {
+    private:
+        struct Cell
+        {
+            Cost gCost = 0;
+            int parent = -1;                // The index of the previous cell of the path.
+            std::uint32_t generation = 0;   // The search that last reached the cell. Older values mean unvisited.
+            bool closed = false;
+        };
+
+        struct OpenEntry
+        {
+            Cost fCost;
+            Cost gCost;
+            int cell;
+        };
+
+        using Kernel = bool (Pathfinder::*)(int start, int end, int mapWidth, int mapHeight, const std::string& map);
+
+        std::vector<Cell> cells;
+        std::vector<OpenEntry> openList;    // A binary heap, cheapest first.
+        std::uint32_t generation = 0;
+        Stats stats;
+        const Landmarks* landmarks = nullptr;
+        const ConnectivityIndex* connectivity = nullptr;
+        Movement movement = Movement::EIGHT_WAY;
+        Heuristic heuristic = Heuristic::OCTILE;
+        Kernel kernel;
+
         /**
-         * Calculates the heuristic value between two points.
-         * The heuristic value is based on the euclidean distance between the two points.
-         *
-         * @param startX The x-coordinate of the start point.
-         * @param startY The y-coordinate of the start point.
-         * @param endX The x-coordinate of the end point.
-         * @param endY The y-coordinate of the end point.
-         * @return The heuristic value between the two points.
+         * @return The search for a movement and a heuristic, nullptr if the heuristic can overestimate.
          */
-        double heuristic(int startX, int startY, int endX, int endY);
+        static Kernel findKernel(Movement movement, Heuristic heuristic);
 
         /**
-         * Checks if a given node is present in a list of nodes.
-         *
-         * @param node The node to check.
-         * @param list The list of nodes to search in.
-         * @return True if the node is found in the list, false otherwise.
+         * @brief Prepares the workspace for a new search on a map of the given size.
          */
-        bool isNodeInList(const NodePtr node, const NodeList& list);
+        void beginSearch(std::size_t cellCount);
 
         /**
-         * Reconstructs the path from the start node to the end node.
-         * 
-         * @param endNode The end node of the path.
-         * @return A vector of pairs representing the coordinates of the nodes in the path.
+         * @brief Searches from a cell to another, leaving the parents in cells. Instantiated for each policy.
          */
-        std::vector<std::pair<int, int>> reconstructPath(NodePtr endNode);
+        template <typename MovementPolicy, typename HeuristicPolicy>
+        bool search(int start, int end, int mapWidth, int mapHeight, const std::string& map);
+
+    public:
+        Pathfinder() : kernel(findKernel(movement, heuristic)) {}
+
+        ~Pathfinder() {}
+
+        /* <------------------------ Getters ------------------------> */
 
         /**
-         * @brief Finds the 8 neighboring nodes of a given node.
-         * 
-         * @param node The node for which to find neighbors.
-         * @param mapWidth The width of the map.
-         * @param mapHeight The height of the map.
-         * @param map The map containing the nodes.
-         * @return The list of neighboring nodes.
+         * @return The statistics of the last search.
          */
-        NodeList findNeighbours(const NodePtr node, int mapWidth, int mapHeight, const std::string & map);
+        const Stats& getStats() const { return stats; }
+
+        Movement getMovement() const { return movement; }
+
+        Heuristic getHeuristic() const { return heuristic; }
+
+        /* <------------------------ Setters ------------------------> */
 
         /**
-         * @brief Evaluates a neighbor node in the A* algorithm.
-         * 
-         * This function calculates the cost and heuristic values for a neighbor node,
-         * and updates its parent and total cost if necessary. It also adds the neighbor
-         * node to the open list if it is not already in the closed list.
-         * 
-         * @param neighbour The neighbor node to evaluate.
-         * @param currentNode The current node being evaluated.
-         * @param endNode The end node of the path.
-         * @param openList The list of nodes to be evaluated.
-         * @param closedList The list of nodes that have already been evaluated.
+         * Sets the landmarks that sharpen the heuristic. They're only used on the map they were built for,
+         * detected by its size, and must outlive their use.
+         *
+         * @param landmarks The landmarks, or nullptr to use the octile distance alone.
          */
-        void evaluateNeighbour(NodePtr neighbour, NodePtr currentNode, const NodePtr endNode,
-                               NodeList& openList, const NodeList& closedList);
-    } // namespace Utils
+        void setLandmarks(const Landmarks* landmarks) { this->landmarks = landmarks; }
 
-    /**
-     * Finds a path from the starting position to the ending position on the given map.
-     * 
-     * @param startX The x-coordinate of the starting position.
-     * @param startY The y-coordinate of the starting position.
-     * @param endX The x-coordinate of the ending position.
-     * @param endY The y-coordinate of the ending position.
-     * @param mapWidth The width of the map.
-     * @param mapHeight The height of the map.
-     * @param map The map represented as a vector of strings.
-     * @return A vector of pairs (x, y) representing the path from the starting position to the ending position.
-     */
-    std::vector<std::pair<int, int>> findPath(int startX, int startY, int endX, int endY, int mapWidth, int mapHeight, const std::string& map);
+        /**
+         * Sets the components of the map, so a search between cells that can't reach each other returns at
+         * once instead of visiting every cell it can reach. Only used on a map of the same size, and must be
+         * kept up to date with it.
+         *
+         * @param connectivity The components, or nullptr to always search.
+         */
+        void setConnectivity(const ConnectivityIndex* connectivity) { this->connectivity = connectivity; }
+
+        /**
+         * Sets how the paths move and how the searches estimate the cost left. Defaults to EIGHT_WAY and
+         * OCTILE.
+         *
+         * @param movement The steps a path can take.
+         * @param heuristic The estimate. MANHATTAN only goes with FOUR_WAY, it overestimates with diagonals.
+         * @return False if the heuristic can overestimate with the movement, leaving the policy unchanged.
+         */
+        bool setPolicy(Movement movement, Heuristic heuristic);
+
+        /* <------------------------ Methods ------------------------> */
+
+        /**
+         * Finds a path from the starting position to the ending position on the given map.
+         *
+         * @param startX The x-coordinate of the starting position.
+         * @param startY The y-coordinate of the starting position.
+         * @param endX The x-coordinate of the ending position.
+         * @param endY The y-coordinate of the ending position.
+         * @param mapWidth The width of the map.
+         * @param mapHeight The height of the map.
+         * @param map The map. Only ' ' cells can be walked on, in the steps of the movement.
+         * @param path Receives the pairs (x, y) from the cell after the start to the end, or nothing if there
+         *             is no path. Its memory is reused.
+         * @return True if a path was found.
+         */
+        bool findPath(int startX, int startY, int endX, int endY, int mapWidth, int mapHeight, const std::string& map,
+                      std::vector<std::pair<int, int>>& path);
+    }; // class Pathfinder
 } // namespace AStar
 
-#endif // ASTAR_HPP
\ No newline at end of file
+#endif // ASTAR_HPP
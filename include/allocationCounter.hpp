@@ -0,0 +1,32 @@
+/**
+ * @file allocationCounter.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief AllocationCounter namespace header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+/**
+ * @namespace AllocationCounter
+ * @brief Counts the calls to the global operator new, per thread.
+ *
+ * The counter is only maintained in debug builds, where the global operator new is replaced. In release
+ * builds the count is always 0. Each thread has its own count, so the game's frames aren't charged with
+ * the allocations of the input thread or of the workers.
+ */
+namespace AllocationCounter
+{
+    /**
+     * @return The number of calls to the global operator new made by the calling thread since it started.
+     */
+    std::size_t count();
+} // namespace AllocationCounter
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -0,0 +1,152 @@
+/**
+ * @file batchPathfinder.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief BatchPathfinder class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef BATCH_PATHFINDER_HPP
+#define BATCH_PATHFINDER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "AStar.hpp"
+#include "maps.hpp"
+#include "scheduler.hpp"
+
+using Path = std::vector<std::pair<int, int>>;
+
+struct PathQuery
+{
+    int startX;
+    int startY;
+    int endX;
+    int endY;
+};
+
+/**
+ * @class PathBatch
+ * @brief The results of queries submitted together to a BatchPathfinder, filled as the workers finish.
+ */
+class PathBatch
+{
+private:
+    friend class BatchPathfinder;
+
+    std::vector<PathQuery> queries;
+    std::vector<Path> paths;                    // paths[i] answers queries[i].
+    std::atomic<std::size_t> expandedNodes{0};
+    std::atomic<int> remainingTasks{0};
+    std::mutex mutex;
+    std::condition_variable done;
+
+public:
+    /* <------------------------ Getters ------------------------> */
+
+    /**
+     * @return True if every path was found. Doesn't block.
+     */
+    bool isReady() const { return remainingTasks.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * @return The paths, in the order of the queries. An empty path means the end can't be reached (or is the
+     * start). Only valid once the batch is ready.
+     */
+    const std::vector<Path>& getPaths() const { return paths; }
+
+    /**
+     * @return The nodes expanded by all the searches. Only valid once the batch is ready.
+     */
+    std::size_t getExpandedNodes() const { return expandedNodes.load(std::memory_order_relaxed); }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * @brief Blocks until every path was found. Must not be called from a task of the scheduler.
+     */
+    void wait();
+};
+
+/**
+ * @class BatchPathfinder
+ * @brief Finds many paths on one map at once, on the threads of a WorkStealingScheduler.
+ *
+ * The queries are split into tasks of a few queries each, so the workers balance the long searches between
+ * them by stealing. Each worker searches with its own AStar::Pathfinder, which keeps its workspace from one
+ * task to the next, and writes each path to the slot of its query, so the results come out in the order of
+ * the queries without any sorting or locking.
+ *
+ * findPaths() blocks until the paths are found; submit() returns at once, and the caller checks
+ * PathBatch::isReady() later, e.g. once per frame.
+ */
+class BatchPathfinder
+{
+private:
+    static constexpr int QUERIES_PER_TASK = 8;
+
+    WorkStealingScheduler& scheduler;
+    std::vector<AStar::Pathfinder> pathfinders;     // One per worker of the scheduler.
+
+public:
+    explicit BatchPathfinder(WorkStealingScheduler& scheduler);
+
+    BatchPathfinder(const BatchPathfinder&) = delete;
+    BatchPathfinder& operator=(const BatchPathfinder&) = delete;
+
+    /* <------------------------ Setters ------------------------> */
+
+    /**
+     * Sets the landmarks used by every worker (see AStar::Pathfinder::setLandmarks()). Must not be called
+     * while a batch is running.
+     */
+    void setLandmarks(const AStar::Landmarks* landmarks);
+
+    /**
+     * Sets the components used by every worker (see AStar::Pathfinder::setConnectivity()). Must not be
+     * called while a batch is running.
+     */
+    void setConnectivity(const ConnectivityIndex* connectivity);
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Queues the searches of a batch of queries.
+     *
+     * @param queries The queries.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     * @param map The map. Must stay alive and unchanged until the batch is ready, like the BatchPathfinder.
+     * @return The batch, to be polled or waited for.
+     */
+    std::shared_ptr<PathBatch> submit(std::vector<PathQuery> queries, int mapWidth, int mapHeight, const std::string& map);
+
+    /**
+     * Finds the paths of a batch of queries and waits for them. Must not be called from a task of the
+     * scheduler.
+     *
+     * @return The paths, in the order of the queries.
+     */
+    std::vector<Path> findPaths(std::vector<PathQuery> queries, int mapWidth, int mapHeight, const std::string& map);
+
+    /**
+     * Finds the paths between random free cells of a map, on one thread without and with landmarks and then
+     * in a batch, then with the other movements of the pathfinder, and prints their throughput, the nodes
+     * they expanded, what the landmarks cost and how many cells could reach each other.
+     *
+     * @param data The map.
+     * @param queryCount The number of paths.
+     * @param threadCount The threads of the batch. 0 uses one per hardware thread.
+     * @param seed The seed of the queries.
+     */
+    static void runBenchmark(const MapData& data, int queryCount, int threadCount, std::uint32_t seed);
+};
+
+#endif // BATCH_PATHFINDER_HPP
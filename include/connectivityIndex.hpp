@@ -0,0 +1,153 @@
+/**
+ * @file connectivityIndex.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief ConnectivityIndex class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef CONNECTIVITY_INDEX_HPP
+#define CONNECTIVITY_INDEX_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConnectivityIndex
+ * @brief Which cells of a map can reach each other, answered in O(1).
+ *
+ * Every cell that isn't a wall is labeled with its component: the cells it can walk to, moving in 8
+ * directions like the pathfinder. Two cells are connected when their labels match. The labels are found with
+ * a flood fill when the map is loaded and kept up to date as cells open and close:
+ * - Opening a cell joins the components around it. The smaller ones take the label of the largest, so the
+ *   cost is the size of the smaller ones.
+ * - Closing a cell can split its component. If the cells around it still touch each other, it can't, and
+ *   nothing else is done. Otherwise a search grows from each side at the same pace until they meet or one
+ *   runs out, and the side that ran out gets a new label, so the cost is the size of the smaller side.
+ *
+ * Each component also lists its cells, in no order, and each cell knows its place in the list. A relabeled
+ * cell moves to the list of its new component in O(1) (a removed cell is replaced by the last one), so the
+ * lists cost nothing more than the relabeling, and a random cell of a component is drawn in O(1).
+ */
+class ConnectivityIndex
+{
+public:
+    static constexpr int NO_COMPONENT = -1;     // The label of walls.
+
+private:
+    static constexpr int OFFSETS_X[8] = { -1, 0, 1, 1, 1, 0, -1, -1 };   // The cells around a cell, in order around it.
+    static constexpr int OFFSETS_Y[8] = { -1, -1, -1, 0, 1, 1, 1, 0 };
+
+    std::vector<int> labels;                    // The component of each cell.
+    std::vector<std::vector<int>> members;      // The cells of each component, empty if the label is unused.
+    std::vector<int> memberPositions;           // The index of each cell in the list of its component.
+    std::vector<int> unusedLabels;
+    int componentCount = 0;
+    int mapWidth = 0;
+    int mapHeight = 0;
+
+    // The workspace of the searches, stamped like the Pathfinder's so it's never cleared
+    std::vector<std::uint32_t> visits;          // The split that last reached each cell.
+    std::vector<std::uint8_t> owners;           // The side of the split that reached the cell.
+    std::uint32_t visit = 0;
+    std::vector<int> queue;
+
+    /**
+     * @brief Calls a function with each cell around a cell, in order around it.
+     */
+    template <typename Function>
+    void forEachNeighbour(int cell, Function&& function) const
+    {
+        const int x = cell % mapWidth;
+        const int y = cell / mapWidth;
+        for (int i = 0; i < 8; ++i)
+        {
+            const int neighbourX = x + OFFSETS_X[i];
+            const int neighbourY = y + OFFSETS_Y[i];
+            if (neighbourX < 0 || neighbourX >= mapWidth || neighbourY < 0 || neighbourY >= mapHeight) continue;
+
+            function(neighbourY * mapWidth + neighbourX);
+        }
+    }
+
+    int newLabel();
+
+    /**
+     * @brief Moves a cell to a component's list, or out of every list for NO_COMPONENT.
+     */
+    void setLabel(int cell, int label);
+
+    void releaseLabel(int label);
+
+    /**
+     * @brief Gives a new label to the component of a cell, with a flood fill.
+     */
+    void relabel(int cell, int label);
+
+    /**
+     * @brief Splits the component of the cells around a closed cell, if they no longer reach each other.
+     */
+    void split(const std::vector<int>& sides);
+
+public:
+    ConnectivityIndex() {}
+
+    ~ConnectivityIndex() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getMapWidth() const { return mapWidth; }
+
+    int getMapHeight() const { return mapHeight; }
+
+    int getComponentCount() const { return componentCount; }
+
+    /**
+     * @return The label of the component of a cell, NO_COMPONENT for walls.
+     */
+    int getComponent(int cell) const { return labels[cell]; }
+
+    /**
+     * @return The number of cells of the component of a cell, 0 for walls.
+     */
+    int getComponentSize(int cell) const { return labels[cell] == NO_COMPONENT ? 0 : int(members[labels[cell]].size()); }
+
+    /**
+     * @return The cells of a component, in no order.
+     */
+    const std::vector<int>& getCells(int component) const { return members[component]; }
+
+    bool isOpen(int cell) const { return labels[cell] != NO_COMPONENT; }
+
+    /**
+     * @return Whether a path exists between two cells. Never true if either is a wall.
+     */
+    bool connected(int from, int to) const { return labels[from] != NO_COMPONENT && labels[from] == labels[to]; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Labels the components of a map. Only '#' cells are walls, so the markers count as open like for
+     * FreeCellIndex, and no path the Pathfinder finds is missed.
+     *
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     */
+    void build(const std::string& map, int mapWidth, int mapHeight);
+
+    /**
+     * @brief Marks a wall as open, joining the components around it. Does nothing if it's open already.
+     */
+    void open(int cell);
+
+    /**
+     * @brief Marks a cell as a wall, splitting its component if needed. Does nothing if it's a wall already.
+     */
+    void close(int cell);
+};
+
+#endif // CONNECTIVITY_INDEX_HPP
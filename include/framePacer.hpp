@@ -0,0 +1,80 @@
+/**
+ * @file framePacer.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief FramePacer class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef FRAME_PACER_HPP
+#define FRAME_PACER_HPP
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @class FramePacer
+ * @brief Spaces the frames of the game loop, sleeping instead of spinning between them.
+ *
+ * Each frame has a deadline, one frame time after the previous one. Waiting for it sleeps most of the
+ * remaining time and spins (yielding) only for the last stretch, because a sleep can end later than asked:
+ * the stretch adapts to the longest recent oversleep, so the frames stay on time without burning the core.
+ * A frame that ends after its deadline counts as missed and moves the next deadlines, so a slow frame
+ * isn't followed by a burst of catch-up frames.
+ *
+ * When nothing on the screen moves, the loop can ask for the idle frame rate, which is much lower.
+ */
+class FramePacer
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double MIN_SPIN_TIME = 0.0002;     // In seconds.
+    static constexpr double MAX_SPIN_TIME = 0.004;
+
+    double targetFrameTime;                 // In seconds. 0 doesn't wait.
+    double idleFrameTime;
+    double spinTime = 0.002;                // How long before the deadline the sleep stops.
+    Clock::time_point deadline = Clock::now();
+    Clock::time_point previousFrame = Clock::now();
+    std::size_t frameCount = 0;
+    std::size_t missedDeadlines = 0;
+
+public:
+    /**
+     * @param targetFps The frames per second. 0 doesn't limit them.
+     * @param idleFps The frames per second when nothing moves.
+     */
+    explicit FramePacer(double targetFps = 60.0, double idleFps = 20.0) { setTargetFps(targetFps); setIdleFps(idleFps); }
+
+    ~FramePacer() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::size_t getFrameCount() const { return frameCount; }
+
+    /**
+     * @return The frames that ended after their deadline.
+     */
+    std::size_t getMissedDeadlines() const { return missedDeadlines; }
+
+    /* <------------------------ Setters ------------------------> */
+
+    void setTargetFps(double fps) { targetFrameTime = fps > 0.0 ? 1.0 / fps : 0.0; }
+
+    void setIdleFps(double fps) { idleFrameTime = fps > 0.0 ? 1.0 / fps : targetFrameTime; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Waits until the next frame is due.
+     *
+     * @param idle Whether the frame can wait for the idle frame rate.
+     * @return The time since the previous frame started, in seconds.
+     */
+    double wait(bool idle);
+};
+
+#endif // FRAME_PACER_HPP
@@ -0,0 +1,98 @@
+/**
+ * @file freeCellIndex.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief FreeCellIndex class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef FREE_CELL_INDEX_HPP
+#define FREE_CELL_INDEX_HPP
+
+#include <random>
+#include <string>
+#include <vector>
+#include "connectivityIndex.hpp"
+
+/**
+ * @class FreeCellIndex
+ * @brief The empty cells of a map, to pick random positions without retrying walls.
+ *
+ * The cells are kept in a dense array, and each cell of the map knows its place in it (or -1), so adding,
+ * removing and drawing a uniformly random cell all take O(1): a removed cell is replaced by the last one.
+ * The index is built when the map is loaded and kept up to date with add() and remove() as cells change.
+ */
+class FreeCellIndex
+{
+private:
+    static constexpr int MAX_TRIES = 16;    // Draws of sample() with a distance before it gives up.
+
+    std::vector<int> cells;                 // The free cells, in no order.
+    std::vector<int> positions;             // The index of each map cell in cells, -1 if it isn't free.
+    int mapWidth = 0;
+
+public:
+    FreeCellIndex() {}
+
+    ~FreeCellIndex() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    bool empty() const { return cells.empty(); }
+
+    std::size_t size() const { return cells.size(); }
+
+    int getMapWidth() const { return mapWidth; }
+
+    bool contains(int cell) const { return cell >= 0 && cell < int(positions.size()) && positions[cell] >= 0; }
+
+    const std::vector<int>& getCells() const { return cells; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Indexes the cells of a map that aren't walls. Markers count as free.
+     *
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     */
+    void build(const std::string& map, int mapWidth);
+
+    /**
+     * @brief Marks a cell as free. Does nothing if it already is.
+     */
+    void add(int cell);
+
+    /**
+     * @brief Marks a cell as blocked. Does nothing if it already is.
+     */
+    void remove(int cell);
+
+    /**
+     * Draws a free cell uniformly.
+     *
+     * @return The index of the cell, -1 if there is none.
+     */
+    int sample(std::mt19937& generator) const;
+
+    /**
+     * Draws a free cell at least some distance away from a point, and reachable from it.
+     *
+     * The distance is the straight line, which no path is shorter than, so the cell is at least as far by
+     * walking too. The cells are drawn from the point's component (see ConnectivityIndex::getCells()), so
+     * each draw is reachable and takes O(1). The draws are bounded: if none of MAX_TRIES is far enough, the
+     * farthest one is returned, so a small map or component never stalls the frame.
+     *
+     * @param generator The generator.
+     * @param x The x coordinate of the point.
+     * @param y The y coordinate of the point.
+     * @param minDistance The smallest distance between the point and the cell's center.
+     * @param connectivity The components of the map, or nullptr if every cell can be reached.
+     * @return The index of the cell, -1 if there is none.
+     */
+    int sample(std::mt19937& generator, double x, double y, double minDistance, const ConnectivityIndex* connectivity = nullptr) const;
+};
+
+#endif // FREE_CELL_INDEX_HPP
@@ -11,12 +11,33 @@
 #define GAME_HPP
 
 #include <iostream>
+#include <array>
+#include <chrono>
 #include <string>
 #include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#endif
+#include "input.hpp"
 #include "player.hpp"
 #include "AStar.hpp"
 #include "objective.hpp"
+#include "trace.hpp"
+#include "allocationCounter.hpp"
+#include "minimap.hpp"
+#include "renderQuality.hpp"
+#include "visibility.hpp"
+#include "sprite.hpp"
+#include "maps.hpp"
+#include "connectivityIndex.hpp"
+#include "freeCellIndex.hpp"
+#include "multiplayerClient.hpp"
+#include "glyphs.hpp"
+#include "framePacer.hpp"
+#include "inputThread.hpp"
+#include "mapEditor.hpp"
+#include "wallTextures.hpp"
+#include "lighting.hpp"
 
 /**
  * @class Game
@@ -29,17 +50,47 @@ class Game
 {
 private:
     std::string map;
-    const int MAP_WIDTH = 66;  
-    const int MAP_HEIGHT = 27;     
+    int MAP_WIDTH = 0;                                  // Set by the loaded map.
+    int MAP_HEIGHT = 0;
+    MapEditor editor;                                   // Opens the doors and destroys the walls, and tells the rest of the game.
+    FreeCellIndex freeCells;                            // The empty cells of the map, where the objective can go.
+    ConnectivityIndex connectivity;                     // Which cells can reach each other.
     const int SCREEN_WIDTH = 120;           
     const int SCREEN_HEIGHT = 40;           
     double deltaTime = 0.0;                             // The time between frames.
+    std::uint32_t frameCount = 0;                       // The number of frames rendered.
     Player player;
     Objective objective;                                // The objective of the game.
     std::vector<std::pair<int, int>> pathToObjective;
+    AStar::Pathfinder pathfinder;                       // Keeps its memory between the searches of the path.
+    std::vector<Ray> rays;                              // The rays of the screen columns, cast every frame.
+    RenderQuality quality;                              // Fog and level of detail of the rays.
+    VisibilityOverlay visibility;                       // Which cells can be seen from each cell: the table shared by the games with this map, plus the edits.
+    std::shared_ptr<const AStar::Landmarks> landmarks;  // Sharpen the heuristic of the pathfinder, shared like the visibility.
+    std::vector<int> hitWalls;                          // The walls the shots hit this frame.
+    WallTextures wallTextures;                          // Sampled where the rays hit the walls.
+    Lighting lighting;                                  // The lamps of the map and the shots flying.
+    SpriteRenderer spriteRenderer = SpriteRenderer(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Minimap minimap = Minimap(SCREEN_WIDTH, SCREEN_HEIGHT - 1);
     bool showMap = true;                                // Whether to show the map on the screen.
     bool showPathToObjective = false;                   // Whether to show the path to the objective on the map.
     bool running = true;    
+    FrameTracer tracer;                                 // Records the stage timings of each frame, if enabled.
+    std::size_t frameAllocations = 0;                   // Calls to operator new by the game thread in the last frame (debug builds only).
+    std::size_t frameStartAllocations = 0;
+    int previousPathX = -1;                             // The player's cell when the path was last found.
+    int previousPathY = -1;
+    double fps = 0.0;                                   // Shown in the debug info, updated a few times per second.
+    std::chrono::high_resolution_clock::time_point lastFpsUpdate = std::chrono::high_resolution_clock::now();
+    std::chrono::steady_clock::time_point frameStart;   // When update() was called.
+    double frameCost = 0.0;                             // The time update() and render() took in the last frame.
+    FramePacer framePacer;                              // Spaces the frames of run().
+    using SceneView = std::array<double, 13>;           // Everything the 3D scene depends on (see captureView()).
+    std::vector<Glyph> sceneCache;                      // The last 3D scene, without the sprites and the 2D objects.
+    SceneView sceneView{};                              // The view of sceneCache.
+    std::uint64_t sceneHash = 0;                        // The hash of sceneView, 0 if there is no scene.
+    std::size_t reusedScenes = 0;                       // Frames that reused the last scene.
+    MultiplayerClient* client = nullptr;                // Set in multiplayer games, where the server simulates.
     
     /* <------------------------ Methods ------------------------> */
 
@@ -47,21 +98,24 @@ private:
      * @brief Performs the initial setup for the game.
      * 
      * This function initializes the game by setting up the necessary components and variables.
-     * It should be called before starting the game loop.
+     * It is called by the constructor, once the map is loaded.
      */
     void initialSetup();
 
     /**
-     * @brief Resets the position of the mouse.
+     * @brief Updates what the game derived from the map after a cell changed, around that cell only.
+     *
+     * @param cell The index of the cell.
+     * @param newTile The tile of the cell now.
      */
-    void resetMousePos();
+    void onMapEdit(int cell, char newTile);
 
     /**
-     * @brief Reads the user input.
+     * @brief Applies the actions requested in a frame to the game.
      * 
-     * @param lastMousePos The last position of the mouse pointer.
+     * @param input The actions requested.
      */
-    void readInput(POINT& lastMousePos);
+    void applyInput(const InputState& input);
 
     /**
      * @brief Moves the player in the game.
@@ -69,9 +123,9 @@ private:
      * This function is responsible for moving the player character in the game.
      * It updates the player's position based on user input.
      * 
-     * @param mouseDeltaX The change in the x-coordinate of the mouse.
+     * @param input The actions requested in this frame.
      */
-    void movePlayer(int mouseDeltaX);
+    void movePlayer(const InputState& input);
 
     /**
      * @brief Finds the path to the objective.
@@ -83,19 +137,24 @@ private:
      */
     void findPathToObjective();
 
+    /**
+     * @brief Copies the predicted player and the objective of the multiplayer client.
+     */
+    void syncWithClient();
+
     /**
      * Renders the 2D objects on the screen.
      *
      * @param screen The screen buffer to render the objects on.
      */
-    void render2dObjects(wchar_t* screen);
+    void render2dObjects(Glyph* screen);
 
     /**
-     * Renders the player shots on the screen.
+     * Renders the shots, and the other players in multiplayer, as sprites hidden by the walls in front of them.
      * 
      * @param screen The screen buffer to render on.
      */
-    void renderPlayerShots(wchar_t* screen);
+    void renderPlayerShots(Glyph* screen);
 
     /**
      * @brief Displays debug information on the screen.
@@ -107,42 +166,195 @@ private:
      * @param screen A pointer to the screen buffer.
      * @param yOffset The offset value for displaying the debug information.
      */
-    void showDebugInfo(wchar_t * screen, size_t &yOffset);
+    void showDebugInfo(Glyph* screen, size_t &yOffset);
 
     /**
      * @brief Creates a wall tile based on the informations of a ray.
      * 
      * This function takes a Ray object as input and calculates the appropriate wall tile
-     * based on the informations of the ray. The wall tile is represented by a wide 
-     * character (wchar_t).
+     * based on the informations of the ray. The wall tile is a glyph of the screen's
+     * palette (see Glyphs). Walls are textured by renderScreenByHeight(), so this is the
+     * tile of their face only.
      * 
      * @param ray The Ray object representing the ray to calculate the wall tile for.
-     * @return The wall tile represented by a wide character (wchar_t).
+     * @param column The screen column of the ray.
+     * @return The glyph of the wall tile.
+     */
+    Glyph createWallTile(Ray& ray, int column) const;
+
+    /**
+     * @brief Shades a wall by its distance.
+     * 
+     * @param ray The ray that hit the wall.
+     * @return The shade, from 0 (hidden) to WallTextures::SHADES - 1 (the darkest glyph).
      */
-    wchar_t createWallTile(Ray& ray) const;
+    int getWallShade(const Ray& ray) const;
 
     /**
      * Renders the 3D scene on the screen.
      *
+     * If the view is the same as in the last frame, the last scene is copied instead and only the columns
+     * showing the objective are redrawn, since its noise changes every frame.
+     *
      * @param screen The screen buffer to render the scene on.
      */
-    void render3dScene(wchar_t* screen);
+    void render3dScene(Glyph* screen);
+
+    /**
+     * Collects everything the 3D scene depends on, except the objective's noise.
+     *
+     * @param settings The quality of the rays.
+     * @param objectiveVisible Whether the rays test the objective.
+     * @return The view.
+     */
+    SceneView captureView(const QualityLevel& settings, bool objectiveVisible) const;
+
+    /**
+     * Hashes a view, so most changed views are told apart without comparing every field.
+     *
+     * @return The hash, never 0.
+     */
+    static std::uint64_t hashView(const SceneView& view);
+
+    /**
+     * @return The angle of the ray of a screen column.
+     */
+    double getColumnAngle(int x) const { return (player.getAngle() + player.getFOV() / 2.0) - (x / float(SCREEN_WIDTH)) * player.getFOV(); }
+
+    /**
+     * @brief Fills the columns skipped when casting a ray every few columns.
+     * 
+     * A skipped column keeps its own angle, for the floor and the fog, and takes the hit of the ray of the
+     * column at its left. If both neighbours hit a wall, the distance is interpolated between them.
+     * 
+     * @param stride The number of columns between cast rays.
+     */
+    void interpolateSkippedColumns(int stride);
 
     /**
      * Renders a column of the screen based on the height of the ray.
      * 
+     * A wall is drawn with the texture of its cell, at the column where the ray hit it and at the mip
+     * level of its height on the screen, brightened by the light of its cell. The floor is lit by the cells
+     * under each row.
+     * 
      * @param ray The ray used for rendering.
      * @param screen The screen buffer to render on.
      * @param x The x-coordinate of the column to render.
-     * @param wallTile The character representing the wall tile.
      */
-    void renderScreenByHeight(Ray& ray, wchar_t* screen, int x, wchar_t wallTile);
+    void renderScreenByHeight(Ray& ray, Glyph* screen, int x);
 
 public:
+    /**
+     * @brief Loads the default map.
+     */
     Game();
 
+    /**
+     * Loads a map.
+     * 
+     * @param data The map, with the player's marker and optionally the objective's (see Maps).
+     */
+    explicit Game(MapData data);
+
     ~Game() {}
 
+    /**
+     * @brief Sets how many map cells each minimap cell covers along each axis.
+     * 
+     * @param scale The downsampling factor. 1 shows the map as it is.
+     */
+    void setMinimapScale(int scale) { minimap.setScale(scale); }
+
+    /**
+     * @brief Sets the frame rate the render quality adapts to.
+     * 
+     * @param fps The target frames per second. 0 always renders at full quality.
+     */
+    void setTargetFps(double fps) { quality.setTargetFps(fps); }
+
+    /**
+     * @brief Sets the frame rate run() is limited to.
+     * 
+     * @param fps The frames per second. 0 doesn't limit them.
+     */
+    void setMaxFps(double fps) { framePacer.setTargetFps(fps); }
+
+    /**
+     * @brief Sets the frame rate of run() while nothing moves and no key is pressed.
+     * 
+     * @param fps The frames per second.
+     */
+    void setIdleFps(double fps) { framePacer.setIdleFps(fps); }
+
+    /**
+     * @brief Sets the distance from which everything is hidden by fog.
+     * 
+     * @param distance The fog distance.
+     */
+    void setFogDistance(double distance) { quality.setMaxFogDistance(distance); }
+
+    /**
+     * @brief Plays a multiplayer game through a connected client.
+     * 
+     * The player is predicted by the client and the shots, the objective and the other players come from the
+     * server. The map must be the server's.
+     * 
+     * @param multiplayerClient The client, which must outlive the game. Null returns to single player.
+     */
+    void attachClient(MultiplayerClient* multiplayerClient) { client = multiplayerClient; }
+
+    /**
+     * @brief Enables the frame tracer.
+     * 
+     * The begin and end of each stage of the game loop are recorded and written to a Chrome Trace 
+     * Event JSON file when the game exits.
+     * 
+     * @param path The path of the trace file.
+     * @param capacity The maximum number of recorded events.
+     */
+    void enableTracing(const std::string& path, std::size_t capacity = FrameTracer::DEFAULT_CAPACITY)
+    {
+        tracer.enable(path, capacity);
+    }
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getScreenWidth() const { return SCREEN_WIDTH; }
+
+    int getScreenHeight() const { return SCREEN_HEIGHT; }
+
+    bool isRunning() const { return running; }
+
+    /**
+     * @brief Seeds the random generators of the game, so the sessions of a server don't share them.
+     * 
+     * @param seed The seed.
+     */
+    void seed(std::uint32_t seed)
+    {
+        player.seed(seed);
+        objective.seed(seed + 1);
+    }
+
+    /**
+     * @brief Advances the game by one frame.
+     * 
+     * Doesn't depend on the platform, so the game can run without a console (e.g. in the server).
+     * 
+     * @param input The actions requested in this frame.
+     * @param frameTime The time since the last frame, in seconds.
+     */
+    void update(const InputState& input, double frameTime);
+
+    /**
+     * @brief Renders the current frame and releases the temporaries of the frame.
+     * 
+     * @param screen The screen buffer, getScreenWidth() x getScreenHeight().
+     */
+    void render(Glyph* screen);
+
+    #ifdef _WIN32
     /**
      * @brief Executes the game loop.
      * 
@@ -150,6 +362,7 @@ public:
      * It continuously updates the game state and renders the game until the game is over.
      */
     void run();
+    #endif
 };
 
 #endif  // GAME_HPP
\ No newline at end of file
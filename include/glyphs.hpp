@@ -0,0 +1,66 @@
+/**
+ * @file glyphs.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief The characters the screen can show.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef GLYPHS_HPP
+#define GLYPHS_HPP
+
+#include <cstdint>
+#include <string>
+
+using Glyph = std::uint16_t;    // A screen cell: the index of its character in the palette.
+
+/**
+ * @namespace Glyphs
+ * @brief The palette of the screen.
+ *
+ * The screen only shows a few hundred characters, so its cells hold 2-byte indices into this palette
+ * instead of 4-byte wide characters. The indices below 128 are the ASCII characters themselves, so a char
+ * can be stored in a cell as it is. Above them come the shades of the walls and the glyphs of the
+ * objective's noise.
+ *
+ * Each glyph's UTF-8 bytes and console character are computed once, so presenting a frame is a gather
+ * from these tables instead of encoding every cell.
+ */
+namespace Glyphs
+{
+    constexpr Glyph LIGHT_SHADE = 128;          // U+2591
+    constexpr Glyph MEDIUM_SHADE = 129;         // U+2592
+    constexpr Glyph DARK_SHADE = 130;           // U+2593
+    constexpr Glyph FULL_BLOCK = 131;           // U+2588
+    constexpr Glyph NOISE = 132;                // U+25CB, a circle flickering on the objective.
+    constexpr Glyph ETHIOPIC_FIRST = 133;       // U+1200, the objective's glyphs
+    constexpr Glyph ETHIOPIC_COUNT = 0x180;     // up to U+137F.
+    constexpr Glyph COUNT = ETHIOPIC_FIRST + ETHIOPIC_COUNT;
+
+    /**
+     * @return The Unicode code point of a glyph. Control characters are shown as spaces.
+     */
+    std::uint32_t toCodePoint(Glyph glyph);
+
+    /**
+     * Appends cells to a string, encoded in UTF-8.
+     *
+     * @param out The string.
+     * @param cells The cells.
+     * @param count The number of cells.
+     */
+    void appendUtf8(std::string& out, const Glyph* cells, int count);
+
+    /**
+     * Converts cells to the wide characters of the Windows console.
+     *
+     * @param out Receives count characters.
+     * @param cells The cells.
+     * @param count The number of cells.
+     */
+    void toWide(wchar_t* out, const Glyph* cells, int count);
+} // namespace Glyphs
+
+#endif // GLYPHS_HPP
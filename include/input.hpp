@@ -0,0 +1,42 @@
+/**
+ * @file input.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief InputState struct header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+struct InputState // The actions requested for a frame, independent of where they come from.
+{
+    // Held keys
+    bool forward = false;
+    bool backward = false;
+    bool left = false;
+    bool right = false;
+    bool zoom = false;          // Widens the FOV while held.
+    bool shoot = false;
+    int mouseDeltaX = 0;        // Horizontal mouse movement since the last frame. Negative turns left.
+
+    // Pressed this frame (toggles)
+    bool toggleFOV = false;
+    bool toggleMap = false;
+    bool togglePath = false;
+    bool use = false;           // Opens or closes the door next to the player.
+    bool quit = false;
+
+    /**
+     * @return True if no action was requested.
+     */
+    bool isEmpty() const
+    {
+        return !forward && !backward && !left && !right && !zoom && !shoot && mouseDeltaX == 0 &&
+               !toggleFOV && !toggleMap && !togglePath && !use && !quit;
+    }
+};
+
+#endif // INPUT_HPP
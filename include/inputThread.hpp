@@ -0,0 +1,107 @@
+/**
+ * @file inputThread.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief InputThread class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef INPUT_THREAD_HPP
+#define INPUT_THREAD_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "input.hpp"
+#include "spscQueue.hpp"
+
+struct InputEvent
+{
+    enum class Type : std::uint8_t
+    {
+        KEY_DOWN,
+        KEY_UP,
+        MOUSE_MOVE,
+    };
+
+    Type type;
+    int value;                                          // The virtual key code, or the horizontal mouse movement.
+    std::chrono::steady_clock::time_point time;         // When the event was read.
+};
+
+/**
+ * @class InputThread
+ * @brief Reads the keyboard and the mouse on a thread of its own, as the events arrive.
+ *
+ * The thread waits for the console's key events and samples the mouse every millisecond, then pushes
+ * timestamped events to a lock-free queue. The game drains the queue once per frame with poll(), so how
+ * long a frame takes doesn't delay the reading, and a key pressed and released between two frames still
+ * acts in the next one.
+ */
+class InputThread
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int KEY_SPACE = 0x20;              // Virtual key codes
+    static constexpr int KEY_ESCAPE = 0x1B;
+
+    SpscQueue<InputEvent, 1024> events;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+
+    std::array<bool, 256> held{};                       // The keys down, as of the last poll().
+    double latency = 0.0;
+
+    /**
+     * @brief Pushes an event, waiting for room if the game is behind. Called by the thread.
+     */
+    void push(const InputEvent& event);
+
+    #ifdef _WIN32
+    void run();
+    #endif
+
+public:
+    InputThread() {}
+
+    ~InputThread() { stop(); }
+
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    /* <------------------------ Getters ------------------------> */
+
+    /**
+     * @return How long the oldest event taken by the last poll() waited in the queue, in seconds.
+     */
+    double getLatency() const { return latency; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    #ifdef _WIN32
+    /**
+     * @brief Starts reading the console's input.
+     */
+    void start();
+    #endif
+
+    /**
+     * @brief Stops the thread. The events not polled yet are dropped.
+     */
+    void stop();
+
+    /**
+     * Takes the events received since the last call.
+     *
+     * @return The actions of this frame: the keys held or pressed since the last frame, the toggles pressed
+     * since the last frame and the sum of the mouse movements.
+     */
+    InputState poll();
+};
+
+#endif // INPUT_THREAD_HPP
@@ -0,0 +1,120 @@
+/**
+ * @file landmarks.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Landmarks class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pathPolicies.hpp"
+
+namespace AStar
+{
+    /**
+     * @class Landmarks
+     * @brief A lower bound of the walking distance between any two cells, from precomputed distances (ALT).
+     *
+     * A few cells near the edges of the map are chosen as landmarks, and the exact walking distance from each
+     * landmark to every cell is computed when the map is loaded, one landmark per thread. By the triangle
+     * inequality, the distance between two cells is at least the difference of their distances to any
+     * landmark, so the largest difference is a heuristic that never overestimates. On mazes it is far closer
+     * to the real distance than a straight line, which only knows about the walls it doesn't see, so A*
+     * expands a fraction of the cells.
+     *
+     * The distances are exact costs, walked with EightWay: no other movement has shorter paths, so the bound
+     * holds for all of them. The distances of a cell to all the landmarks are stored together, so a lookup
+     * reads one cache line. The table never changes once built and is shared by the games that load the same
+     * map (see share()).
+     */
+    class Landmarks
+    {
+    private:
+        static constexpr Cost UNREACHABLE = std::numeric_limits<Cost>::max();
+
+        std::vector<Cost> distances;        // distances[cell * count + landmark]
+        std::vector<int> cells;             // The landmarks.
+        int count = 0;
+        int mapWidth = 0;
+        int mapHeight = 0;
+
+        /**
+         * @brief Computes the walking distance from a cell to every cell, with Dijkstra's algorithm.
+         */
+        static void computeDistances(const std::string& map, int mapWidth, int mapHeight, int source, std::vector<Cost>& result);
+
+    public:
+        Landmarks() {}
+
+        ~Landmarks() {}
+
+        /* <------------------------ Getters ------------------------> */
+
+        int getCount() const { return count; }
+
+        int getMapWidth() const { return mapWidth; }
+
+        int getMapHeight() const { return mapHeight; }
+
+        const std::vector<int>& getCells() const { return cells; }
+
+        std::size_t getMemoryUsage() const { return distances.size() * sizeof(Cost) + cells.size() * sizeof(int); }
+
+        /* <------------------------ Methods ------------------------> */
+
+        /**
+         * Chooses the landmarks of a map and computes their distances.
+         *
+         * @param map The game map. Only ' ' cells can be walked on, like for the Pathfinder.
+         * @param mapWidth The width of the map.
+         * @param mapHeight The height of the map.
+         * @param landmarkCount How many landmarks to place. More give a closer bound but cost memory.
+         */
+        void build(const std::string& map, int mapWidth, int mapHeight, int landmarkCount = 8);
+
+        /**
+         * Returns the landmarks of a map, built by the first caller and shared by everyone holding them. They
+         * are released with their last holder.
+         *
+         * @param map The game map.
+         * @param mapWidth The width of the map.
+         * @param mapHeight The height of the map.
+         * @return The landmarks, never null.
+         */
+        static std::shared_ptr<const Landmarks> share(const std::string& map, int mapWidth, int mapHeight);
+
+        /**
+         * Computes a lower bound of the walking distance between two cells.
+         *
+         * @param from The index of the first cell.
+         * @param to The index of the second cell.
+         * @return The bound, 0 if no landmark reaches both cells.
+         */
+        Cost lowerBound(int from, int to) const
+        {
+            const Cost* fromDistances = &distances[std::size_t(from) * count];
+            const Cost* toDistances = &distances[std::size_t(to) * count];
+
+            Cost bound = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (fromDistances[i] == UNREACHABLE || toDistances[i] == UNREACHABLE) continue;
+
+                const Cost difference = fromDistances[i] > toDistances[i] ? fromDistances[i] - toDistances[i] : toDistances[i] - fromDistances[i];
+                bound = std::max(bound, difference);
+            }
+
+            return bound;
+        }
+    };
+} // namespace AStar
+
+#endif // LANDMARKS_HPP
@@ -0,0 +1,154 @@
+/**
+ * @file lighting.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Lighting class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef LIGHTING_HPP
+#define LIGHTING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "glyphs.hpp"
+
+/**
+ * @class Lighting
+ * @brief The light of every cell of the map, from the lamps and from the shots flying.
+ *
+ * The lamps ('o') are baked into a lightmap when the map is loaded: each cell adds the light of the lamps
+ * within STATIC_RADIUS it can see, in parallel by rows. The shots are point lights moving every frame, so
+ * their light is splatted around them, within DYNAMIC_RADIUS, into a small spatial hash keyed by cell
+ * instead of a second lightmap: nothing has to be cleared but the cells they lit.
+ *
+ * Both are combined into one light level per cell, updated only where they change, so the renderer reads
+ * a byte per pixel and picks its glyph from a table instead of adding lights per pixel.
+ */
+class Lighting
+{
+public:
+    static constexpr int LEVELS = 4;                // From 0, the light of the map without lamps.
+    static constexpr int FLOOR_BANDS = 4;           // The glyphs of the floor, from the nearest.
+    static constexpr int STATIC_RADIUS = 8;         // The cells a lamp reaches.
+    static constexpr int DYNAMIC_RADIUS = 3;        // The cells a shot reaches.
+    static constexpr int MAX_DYNAMIC_LIGHTS = 32;   // The shots past them don't light.
+
+private:
+    static constexpr int HASH_BITS = 12;            // Room for the cells of MAX_DYNAMIC_LIGHTS lights, half full.
+    static constexpr int HASH_SIZE = 1 << HASH_BITS;
+
+    const std::string* map = nullptr;
+    int mapWidth = 0;
+    int mapHeight = 0;
+    std::vector<int> lamps;                         // The cells of the lamps.
+    std::vector<std::uint8_t> staticLight;          // The light of the lamps in each cell, up to 255.
+    std::vector<std::uint8_t> levels;               // The light level of each cell, lamps and shots.
+    std::vector<int> hashCells;                     // The spatial hash of the shots' light: the cell of each slot, or -1.
+    std::vector<std::uint16_t> hashLight;           // The light of each slot.
+    std::vector<int> litSlots;                      // The slots in use, to empty them.
+    int dynamicLights = 0;                          // Added since clearDynamicLights().
+    std::uint32_t version = 0;                      // Incremented when a level changes.
+    Glyph floorGlyphs[FLOOR_BANDS][LEVELS];
+
+    /**
+     * Checks if a point sees a cell: no wall stands on the line to its center, except the cell itself, so
+     * the walls are lit too.
+     */
+    bool hasLineOfSight(double fromX, double fromY, int toCell) const;
+
+    /**
+     * @return The light of the lamps in a cell.
+     */
+    std::uint8_t bakeCell(int cell) const;
+
+    /**
+     * @return The slot of a cell in the spatial hash, or the empty slot where it goes.
+     */
+    int findSlot(int cell) const;
+
+    /**
+     * @brief Recomputes the level of a cell from its static and dynamic light.
+     */
+    void refreshLevel(int cell);
+
+public:
+    /**
+     * @brief Builds the glyph tables.
+     */
+    Lighting();
+
+    ~Lighting() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::uint32_t getVersion() const { return version; }
+
+    std::size_t getLampCount() const { return lamps.size(); }
+
+    /**
+     * @return The light level of a cell, 0 outside the map.
+     */
+    int getLevel(int x, int y) const
+    {
+        if (x < 0 || x >= mapWidth || y < 0 || y >= mapHeight) return 0;
+        return levels[y * mapWidth + x];
+    }
+
+    /**
+     * @return The light level of a cell by its index, 0 for -1 (outside the map).
+     */
+    int getLevel(int cell) const { return cell < 0 ? 0 : levels[cell]; }
+
+    /**
+     * @param band The band of the floor, from 0 (the nearest) to FLOOR_BANDS - 1.
+     * @return The glyphs of the band by light level.
+     */
+    const Glyph* getFloorGlyphs(int band) const { return floorGlyphs[band]; }
+
+    /**
+     * Brightens the shade of a wall (see WallTextures::getShades()).
+     *
+     * @param shade The shade of the wall by its distance, 0 if hidden.
+     * @param level The light level of the wall.
+     * @param maxShade The darkest shade.
+     * @return The shade, still 0 if hidden.
+     */
+    static int lightShade(int shade, int level, int maxShade) { return shade == 0 ? 0 : std::min(maxShade, shade + level); }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Takes the lamps out of a map, leaving empty cells, and bakes their light. The map must outlive the
+     * lighting.
+     *
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     */
+    void load(std::string& map, int mapWidth, int mapHeight);
+
+    /**
+     * @brief Bakes the lamps again around a cell that changed, as far as the lines of sight through it reach.
+     */
+    void updateAround(int cell);
+
+    /**
+     * @brief Removes the light of the shots.
+     */
+    void clearDynamicLights();
+
+    /**
+     * @brief Adds a point light, lighting the cells around it that it sees.
+     *
+     * @param x The x coordinate of the light.
+     * @param y The y coordinate of the light.
+     */
+    void addDynamicLight(double x, double y);
+};
+
+#endif // LIGHTING_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file localSocket.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Thin wrapper over local (Unix-domain) stream sockets.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef LOCAL_SOCKET_HPP
+#define LOCAL_SOCKET_HPP
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace LocalSocket
+ * @brief Unix-domain stream sockets on POSIX and on Windows 10+ (AF_UNIX through Winsock).
+ *
+ * Only the few operations used by the servers and their clients are wrapped. All the sockets are
+ * non-blocking, so a game loop never waits on the other side.
+ */
+namespace LocalSocket
+{
+    using Handle = std::intptr_t;
+    constexpr Handle INVALID = -1;
+
+    /**
+     * @brief Initializes the socket library. Must be called once before any other function.
+     *
+     * @return True on success.
+     */
+    bool initialize();
+
+    /**
+     * Creates a non-blocking socket listening on a path. An old socket file at the path is removed.
+     *
+     * @param path The path of the socket file.
+     * @return The listening socket, or INVALID on failure.
+     */
+    Handle listen(const std::string& path);
+
+    /**
+     * Accepts a pending connection, without blocking.
+     *
+     * @param listener The listening socket.
+     * @return The non-blocking client socket, or INVALID if there is no pending connection.
+     */
+    Handle accept(Handle listener);
+
+    /**
+     * Connects to a listening socket. The returned socket is non-blocking.
+     *
+     * @param path The path of the socket file.
+     * @return The socket, or INVALID on failure.
+     */
+    Handle connect(const std::string& path);
+
+    /**
+     * Receives the available bytes, up to size.
+     *
+     * @return The number of bytes received, 0 if none is available yet, or -1 if the connection is closed.
+     */
+    int receive(Handle socket, void* buffer, int size);
+
+    /**
+     * Sends as many bytes as possible without blocking.
+     *
+     * @return The number of bytes sent, 0 if the socket buffer is full, or -1 if the connection is closed.
+     */
+    int send(Handle socket, const void* data, int size);
+
+    /**
+     * Closes a socket. Does nothing with INVALID.
+     */
+    void close(Handle socket);
+} // namespace LocalSocket
+
+#endif // LOCAL_SOCKET_HPP
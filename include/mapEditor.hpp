@@ -0,0 +1,110 @@
+/**
+ * @file mapEditor.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MapEditor class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MAP_EDITOR_HPP
+#define MAP_EDITOR_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class MapEditor
+ * @brief Changes the cells of the map while the game runs, and tells the structures derived from it.
+ *
+ * Doors ('D') and destructible walls ('%') are loaded as walls ('#'), so everything that reads the map sees
+ * them like any other wall, and the editor remembers which cells they are. Each edit writes the cell and
+ * calls the listeners with it. A listener updates its own data around that cell only, so an edit costs the
+ * size of the change, not the size of the map.
+ */
+class MapEditor
+{
+public:
+    using Listener = std::function<void(int cell, char oldTile, char newTile)>;
+
+    enum class CellKind : std::uint8_t
+    {
+        FIXED,
+        DOOR,               // Opened and closed by the player.
+        DESTRUCTIBLE,       // A wall until a shot hits it.
+    };
+
+private:
+    std::string* map = nullptr;
+    int mapWidth = 0;
+    int mapHeight = 0;
+    std::vector<CellKind> kinds;
+    std::vector<int> doors;
+    std::vector<Listener> listeners;
+    std::uint32_t version = 0;          // Incremented by every edit.
+
+public:
+    MapEditor() {}
+
+    ~MapEditor() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::uint32_t getVersion() const { return version; }
+
+    const std::vector<int>& getDoors() const { return doors; }
+
+    CellKind getKind(int cell) const { return kinds[cell]; }
+
+    /**
+     * @return The map with every door open and every destructible wall destroyed. No path is shorter in any
+     * other state of the map, so bounds computed on it hold whatever the edits.
+     */
+    std::string getOpenMap() const;
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Takes the doors and the destructible walls out of a map, leaving walls, and edits the map from then on.
+     * The map must outlive the editor.
+     *
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     */
+    void load(std::string& map, int mapWidth, int mapHeight);
+
+    /**
+     * @brief Adds a function called after each edit, with the cell and its tiles before and after.
+     */
+    void addListener(Listener listener) { listeners.push_back(std::move(listener)); }
+
+    /**
+     * Changes a cell and tells the listeners.
+     *
+     * @return False if the cell already had the tile.
+     */
+    bool setTile(int cell, char tile);
+
+    /**
+     * Opens the door next to a position, or closes it if it's open and nobody stands in it. The door cells
+     * next to each other are one door, and change together.
+     *
+     * @param x The x coordinate of the position.
+     * @param y The y coordinate of the position.
+     * @return The number of cells changed.
+     */
+    int toggleDoorsAround(double x, double y);
+
+    /**
+     * Destroys a destructible wall.
+     *
+     * @return False if the cell isn't a destructible wall standing.
+     */
+    bool destroy(int cell);
+};
+
+#endif // MAP_EDITOR_HPP
@@ -0,0 +1,56 @@
+/**
+ * @file maps.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Game maps.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MAPS_HPP
+#define MAPS_HPP
+
+#include <cstdint>
+#include <string>
+
+struct MapData // A map and its size. Row y of the map starts at tiles[y * width].
+{
+    std::string tiles;
+    int width = 0;
+    int height = 0;
+};
+
+/**
+ * @namespace Maps
+ * @brief The maps the game can load.
+ *
+ * '#' is a wall and ' ' is empty. One of '<', '>', '^' and 'v' marks where the player starts, looking at
+ * that direction, and 'X' marks the first position of the objective. 'D' is a closed door and '%' a wall
+ * that shots destroy (see MapEditor). 'o' is a lamp standing in an empty cell (see Lighting).
+ */
+namespace Maps
+{
+    /**
+     * @return The hand-made map of the game.
+     */
+    MapData defaultMap();
+
+    /**
+     * Generates a maze with corridors as wide as the ones of the default map.
+     *
+     * The maze is a grid of rooms split into square tiles, each carved into a random spanning tree by a
+     * thread of its own. The tiles are then joined by one passage per edge of a random spanning tree of the
+     * tiles, so the whole maze is a tree: every empty cell is reachable from any other. The result only
+     * depends on the seed, not on the number of threads.
+     *
+     * @param width The largest width of the map. Rounded down to fit whole rooms.
+     * @param height The largest height of the map. Rounded down to fit whole rooms.
+     * @param seed The seed.
+     * @param corridorWidth The width of the rooms and corridors, in cells.
+     * @return The maze, with the player's and the objective's markers in random rooms.
+     */
+    MapData generateMaze(int width, int height, std::uint32_t seed, int corridorWidth = 4);
+} // namespace Maps
+
+#endif // MAPS_HPP
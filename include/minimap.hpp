@@ -0,0 +1,120 @@
+/**
+ * @file minimap.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Minimap class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MINIMAP_HPP
+#define MINIMAP_HPP
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "glyphs.hpp"
+
+/**
+ * @class Minimap
+ * @brief Renders the map of the game on a corner of the screen.
+ *
+ * The static part of the minimap (the walls) is pre-rendered in a background layer, which is rebuilt only
+ * when the map changes and copied to the screen row by row. The dynamic markers (player, shots, path...) are
+ * plotted over it every frame.
+ *
+ * Maps bigger than the viewport are scrolled to keep the player in view, and can be downsampled so each
+ * minimap cell covers a block of map cells.
+ */
+class Minimap
+{
+private:
+    std::vector<Glyph> background;      // The pre-rendered walls, backgroundWidth x backgroundHeight.
+    int backgroundWidth = 0;
+    int backgroundHeight = 0;
+    int maxViewWidth;                   // The largest viewport, in screen cells.
+    int maxViewHeight;
+    int viewX = 0;                      // Top-left corner of the viewport in the background.
+    int viewY = 0;
+    int scale = 1;                      // Map cells per minimap cell, along each axis.
+    bool dirty = true;                  // Whether the background must be rebuilt.
+
+public:
+    Minimap(int maxViewWidth, int maxViewHeight) : maxViewWidth(maxViewWidth), maxViewHeight(maxViewHeight) {}
+
+    ~Minimap() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getScale() const { return scale; }
+
+    int getViewWidth() const { return std::min(maxViewWidth, backgroundWidth); }
+
+    int getViewHeight() const { return std::min(maxViewHeight, backgroundHeight); }
+
+    /* <------------------------ Setters ------------------------> */
+
+    void setScale(int newScale)
+    {
+        scale = newScale < 1 ? 1 : newScale;
+        dirty = true;
+    }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * @brief Marks the background as outdated. Must be called when the map changes.
+     */
+    void markDirty() { dirty = true; }
+
+    /**
+     * Rebuilds the background if it is outdated.
+     *
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     */
+    void update(const std::string& map, int mapWidth, int mapHeight);
+
+    /**
+     * Redraws the background where a cell of the map changed, instead of all of it.
+     *
+     * @param map The game map, with the change.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     * @param cell The index of the changed cell.
+     */
+    void updateCell(const std::string& map, int mapWidth, int mapHeight, int cell);
+
+    /**
+     * Scrolls the viewport to center it on a position of the map, without leaving the background.
+     *
+     * @param mapX The x-coordinate of the position.
+     * @param mapY The y-coordinate of the position.
+     */
+    void scrollTo(int mapX, int mapY);
+
+    /**
+     * Copies the visible part of the background to the screen.
+     *
+     * @param screen The screen buffer.
+     * @param screenWidth The width of the screen.
+     * @param yOffset The first screen row of the minimap.
+     */
+    void blit(Glyph* screen, int screenWidth, int yOffset) const;
+
+    /**
+     * Draws a marker over the minimap. Markers out of the viewport are ignored.
+     *
+     * @param screen The screen buffer.
+     * @param screenWidth The width of the screen.
+     * @param yOffset The first screen row of the minimap.
+     * @param mapX The x-coordinate of the marker in the map.
+     * @param mapY The y-coordinate of the marker in the map.
+     * @param tile The character of the marker.
+     */
+    void plot(Glyph* screen, int screenWidth, int yOffset, int mapX, int mapY, Glyph tile) const;
+};
+
+#endif // MINIMAP_HPP
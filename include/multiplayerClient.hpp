@@ -0,0 +1,183 @@
+/**
+ * @file multiplayerClient.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MultiplayerClient class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MULTIPLAYER_CLIENT_HPP
+#define MULTIPLAYER_CLIENT_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+#include "input.hpp"
+#include "localSocket.hpp"
+#include "netProtocol.hpp"
+#include "player.hpp"
+
+struct RemotePlayer // Another player, as seen in the last snapshot.
+{
+    double x;
+    double y;
+    char tile;
+};
+
+/**
+ * @class MultiplayerClient
+ * @brief Connects to a MultiplayerServer, sends the input and predicts the player's movement.
+ *
+ * The frames are merged into commands of up to COMMAND_INTERVAL while the input doesn't change, so a fast
+ * client doesn't send more. Each command is applied locally as it is sent, with the same code as the server,
+ * and kept until a snapshot reports it applied. When a snapshot arrives, the player is reset to the server's
+ * state and the commands the server hasn't applied yet are replayed on top, so the player moves without
+ * waiting for the server and only jumps if the server disagrees (a correction).
+ */
+class MultiplayerClient
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double COMMAND_INTERVAL = 1.0 / 60.0;     // The most time merged in a command, in seconds.
+
+    LocalSocket::Handle socket = LocalSocket::INVALID;
+    Net::MessageBuffer incoming;
+    std::string outgoing;                                       // Messages not fully sent yet.
+    std::size_t outgoingOffset = 0;
+
+    int playerId = -1;                                          // The slot given by the server.
+    double tickRate = 30.0;
+    std::string map;
+    int mapWidth = 0;
+    int mapHeight = 0;
+
+    std::array<Net::WorldState, Net::HISTORY_SIZE> history;    // The last snapshots, at tick % HISTORY_SIZE.
+    Net::WorldState decoded;                                    // Scratch for the snapshot being decoded.
+    std::uint32_t latestTick = 0;
+    Clock::time_point latestTime;                               // When the latest snapshot arrived.
+
+    Player predicted;                                           // The server's state plus the pending commands.
+    Player displayed;                                           // predicted plus the command being merged.
+    std::deque<Net::Command> pending;                           // Sent, not yet applied by the server.
+    std::uint32_t nextSequence = 1;
+    InputState openInput;                                       // The input of the command being merged.
+    double openTime = 0.0;                                      // The time merged in it, 0 if there is none.
+    double timeDebt = 0.0;                                      // Time lost rounding the commands to milliseconds.
+
+    std::vector<RemotePlayer> remotePlayers;
+    std::vector<std::pair<double, double>> shots;               // All the shots, moved to the current time.
+
+    // Statistics
+    std::size_t bytesReceived = 0;
+    std::size_t bytesSent = 0;
+    std::size_t snapshotCount = 0;
+    std::size_t correctionCount = 0;
+    double correctionDistance = 0.0;                            // Sum of the corrections' distances.
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * @brief Reads the available messages. Returns false if the connection was closed or its stream is malformed.
+     */
+    bool receive();
+
+    bool readWelcome(std::string_view payload);
+
+    void readMap(std::string_view payload);
+
+    void readSnapshot(std::string_view payload);
+
+    /**
+     * @brief Sends the command being merged and applies it to the prediction.
+     */
+    void sendOpenCommand();
+
+    void flush();
+
+    /**
+     * @brief Updates the remote players and the shots from the latest snapshot.
+     */
+    void updateView();
+
+public:
+    MultiplayerClient() {}
+
+    ~MultiplayerClient() { LocalSocket::close(socket); }
+
+    MultiplayerClient(const MultiplayerClient&) = delete;
+    MultiplayerClient& operator=(const MultiplayerClient&) = delete;
+
+    /**
+     * Connects to a server and waits for its welcome.
+     *
+     * @param path The path of the server's socket.
+     * @param timeout The longest wait, in seconds.
+     * @return False if the server couldn't be reached or is full.
+     */
+    bool connect(const std::string& path, double timeout = 2.0);
+
+    /**
+     * Sends the input of a frame, predicts the player and applies the received snapshots.
+     *
+     * @param input The actions requested in this frame. Only the movement, the turning and the shooting are
+     * sent.
+     * @param frameTime The time since the last frame, in seconds.
+     */
+    void update(const InputState& input, double frameTime);
+
+    /* <------------------------ Getters ------------------------> */
+
+    bool isConnected() const { return socket != LocalSocket::INVALID; }
+
+    int getPlayerId() const { return playerId; }
+
+    const std::string& getMap() const { return map; }
+
+    int getMapWidth() const { return mapWidth; }
+
+    int getMapHeight() const { return mapHeight; }
+
+    /**
+     * @return The local player, as predicted.
+     */
+    const Player& getPlayer() const { return displayed; }
+
+    const std::vector<RemotePlayer>& getRemotePlayers() const { return remotePlayers; }
+
+    const std::vector<std::pair<double, double>>& getShots() const { return shots; }
+
+    int getObjectiveX() const { return history[latestTick % Net::HISTORY_SIZE].objectiveX; }
+
+    int getObjectiveY() const { return history[latestTick % Net::HISTORY_SIZE].objectiveY; }
+
+    std::size_t getBytesReceived() const { return bytesReceived; }
+
+    std::size_t getBytesSent() const { return bytesSent; }
+
+    std::size_t getSnapshotCount() const { return snapshotCount; }
+
+    std::size_t getCorrectionCount() const { return correctionCount; }
+
+    double getCorrectionDistance() const { return correctionDistance; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Connects headless clients that wander randomly, then prints their bandwidth and corrections. Used to
+     * test a server over loopback.
+     *
+     * @param path The path of the server's socket.
+     * @param count The number of clients.
+     * @param duration How long they play, in seconds.
+     */
+    static void runBots(const std::string& path, int count, double duration);
+};
+
+#endif // MULTIPLAYER_CLIENT_HPP
@@ -0,0 +1,139 @@
+/**
+ * @file multiplayerServer.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MultiplayerServer class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef MULTIPLAYER_SERVER_HPP
+#define MULTIPLAYER_SERVER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "connectivityIndex.hpp"
+#include "freeCellIndex.hpp"
+#include "localSocket.hpp"
+#include "maps.hpp"
+#include "netProtocol.hpp"
+#include "objective.hpp"
+#include "player.hpp"
+
+/**
+ * @class MultiplayerServer
+ * @brief Simulates the players, their shots and the shared objective of a multiplayer game.
+ *
+ * Clients connect to a local socket and get a player slot. Their commands are applied as they arrive and,
+ * every tick, the world is captured and sent to each client as a delta from the last snapshot that client
+ * acknowledged (or in full if it's too old). Clients that acknowledged the same tick get the same delta, so
+ * it is encoded once per distinct baseline, not once per client. A client whose socket is full skips
+ * snapshots until it drains, and the next delta still applies to its acknowledged baseline.
+ */
+class MultiplayerServer
+{
+public:
+    struct Config
+    {
+        int maxPlayers = 8;
+        double tickRate = 30.0;                             // Ticks per second.
+        std::string socketPath = "ascii-shooter-mp.sock";
+        double reportInterval = 5.0;                        // Seconds between the reports. 0 disables them.
+        double duration = 0.0;                              // Seconds to run. 0 runs until the process is killed.
+        std::uint32_t seed = 1;
+        MapData map = Maps::defaultMap();
+    };
+
+private:
+    static constexpr int MAX_COMMANDS_PER_TICK = 32;        // Bounds the work a flooding client can cause.
+    static constexpr int TIME_BANK_TICKS = 2;               // The most simulated time a client banks, in ticks.
+    static constexpr std::size_t MAX_INCOMING_BYTES = 64 * 1024;    // Buffered from a client, far past what it sends in a tick.
+
+    struct Client
+    {
+        LocalSocket::Handle socket = LocalSocket::INVALID;
+        Player player;
+        Net::MessageBuffer incoming;
+        std::string outgoing;                               // Messages not fully sent yet.
+        std::size_t outgoingOffset = 0;
+        std::uint32_t lastSequence = 0;                     // The last command applied.
+        std::uint32_t ackTick = 0;                          // The last snapshot received, 0 if none.
+        double timeBank = 0.0;                              // Milliseconds its commands may still simulate.
+        std::size_t bytesSent = 0;                          // Since the last report.
+    };
+
+    Config config;
+    std::string map;                                        // The simulated map: walls and empty cells.
+    std::string clientMap;                                  // The map sent to the clients, with the lamps.
+    int mapWidth = 0;
+    int mapHeight = 0;
+    FreeCellIndex freeCells;                                // Where the players spawn and the objective goes.
+    ConnectivityIndex connectivity;                         // Keeps the objective where the player can reach it.
+    Objective objective;
+    std::vector<Client> clients;                            // One per player slot.
+    std::array<Net::WorldState, Net::HISTORY_SIZE> history; // The last snapshots, at tick % HISTORY_SIZE.
+    std::uint32_t tick = 0;
+    std::mt19937 generator;                                 // Picks the spawn points.
+    LocalSocket::Handle listener = LocalSocket::INVALID;
+
+    std::vector<std::pair<std::uint32_t, std::string>> encodedDeltas;  // (baseline tick, delta) of this tick.
+
+    // Since the last report
+    std::vector<double> tickCosts;                          // In microseconds.
+    std::size_t fullSnapshots = 0;
+    std::size_t deltaSnapshots = 0;
+    std::size_t encodings = 0;
+
+    /* <------------------------ Methods ------------------------> */
+
+    void acceptClients();
+
+    /**
+     * Applies the commands received from a client. Each tick adds the tick's length to the time its commands
+     * may simulate, up to TIME_BANK_TICKS ticks, so the commands that arrive late together still apply but a
+     * client can't move faster than real time by claiming longer frames.
+     */
+    void readCommands(int slot);
+
+    /**
+     * @brief Moves the shots and the objective, then records the world of this tick.
+     */
+    void simulate();
+
+    void captureWorld();
+
+    /**
+     * @brief Sends the snapshot of this tick to every client that has drained its previous messages.
+     */
+    void sendSnapshots();
+
+    /**
+     * @return The delta from a baseline to the world of this tick, encoded once per tick.
+     */
+    const std::string& encodedDelta(const Net::WorldState& baseline);
+
+    void flush(Client& client);
+
+    void disconnect(int slot);
+
+    void report(double elapsed);
+
+public:
+    explicit MultiplayerServer(const Config& config);
+
+    ~MultiplayerServer();
+
+    /**
+     * @brief Runs the game until the configured duration ends.
+     *
+     * @return False if the socket couldn't be opened.
+     */
+    bool run();
+};
+
+#endif // MULTIPLAYER_SERVER_HPP
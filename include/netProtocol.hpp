@@ -0,0 +1,296 @@
+/**
+ * @file netProtocol.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Messages exchanged by the multiplayer server and its clients.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef NET_PROTOCOL_HPP
+#define NET_PROTOCOL_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "input.hpp"
+
+class Player;
+
+/**
+ * @namespace Net
+ * @brief The multiplayer protocol.
+ *
+ * Every message is framed as [length: varint][type: u8][payload], little-endian. The length covers the type
+ * and the payload and takes at most LENGTH_BYTES bytes.
+ *
+ * - WELCOME (server to client): the player slot, the tick rate and the size of the map.
+ * - MAP (server to client): the next rows of the map, as runs of the same tile. As many as needed follow
+ *   WELCOME, so maps of any size fit in the messages.
+ * - COMMAND (client to server): the input of one client frame, numbered, and the last snapshot received.
+ * - SNAPSHOT (server to client): the world at a tick, as a delta from the last snapshot the client received.
+ *
+ * Positions are sent as fixed point (1/256 of a cell) and angles as 1/65536 of a turn. The server rounds the
+ * players to these values after every command, so the client predicts its movement from exactly the state
+ * the server has. Shots move in straight lines, so only their spawn is sent: the client moves them itself.
+ */
+namespace Net
+{
+    constexpr int MAX_PLAYERS = 32;
+    constexpr int HISTORY_SIZE = 64;        // Snapshots kept to decode or encode deltas. Must be a power of 2.
+    constexpr std::size_t LENGTH_BYTES = 3;
+    constexpr std::size_t MAX_MESSAGE_SIZE = (std::size_t(1) << (7 * LENGTH_BYTES)) - 1;   // The longest length that fits.
+    constexpr int MAX_COMMAND_MILLISECONDS = 100;   // The longest command the server applies, the shortest is 1 ms.
+
+    enum class MessageType : std::uint8_t
+    {
+        WELCOME = 1,
+        COMMAND = 2,
+        SNAPSHOT = 3,
+        MAP = 4,
+    };
+
+    enum Buttons : std::uint8_t
+    {
+        FORWARD = 1 << 0,
+        BACKWARD = 1 << 1,
+        LEFT = 1 << 2,
+        RIGHT = 1 << 3,
+        SHOOT = 1 << 4,
+    };
+
+    struct Command // The input of one client frame.
+    {
+        std::uint32_t sequence = 0;         // Increases by 1 with every command of a client.
+        std::uint8_t buttons = 0;
+        std::int8_t turn = 0;               // -1 turns left, 1 turns right.
+        std::uint8_t milliseconds = 0;      // The frame time, which the server and the prediction both use.
+    };
+
+    struct PlayerState
+    {
+        bool active = false;
+        std::uint32_t x = 0;
+        std::uint32_t y = 0;
+        std::uint16_t angle = 0;
+    };
+
+    struct ShotState // A shot as fired. Its position at a later tick is extrapolated.
+    {
+        std::uint32_t id = 0;               // The owner's slot in the top byte, the owner's shot id in the others.
+        std::uint32_t spawnTick = 0;
+        std::uint32_t x = 0;
+        std::uint32_t y = 0;
+        std::uint16_t angle = 0;
+        std::uint8_t speed = 0;             // In 1/16 cell per second.
+    };
+
+    struct WorldState
+    {
+        std::uint32_t tick = 0;             // 0 is the empty world, the baseline of full snapshots.
+        std::uint32_t objectiveX = 0;       // In cells.
+        std::uint32_t objectiveY = 0;
+        std::array<PlayerState, MAX_PLAYERS> players;
+        std::vector<ShotState> shots;       // Sorted by id.
+    };
+
+    /* <------------------------ Quantization ------------------------> */
+
+    inline std::uint32_t quantizePosition(double position) { return std::uint32_t(position * 256.0 + 0.5); }
+
+    inline double dequantizePosition(std::uint32_t position) { return position / 256.0; }
+
+    std::uint16_t quantizeAngle(double angle);
+
+    double dequantizeAngle(std::uint16_t angle);
+
+    /**
+     * Rounds the position and the angle of a player to what a snapshot can carry.
+     */
+    void snapPlayer(Player& player);
+
+    /**
+     * Computes the position of a shot at a tick.
+     */
+    void shotPosition(const ShotState& shot, double tick, double tickRate, double& x, double& y);
+
+    /* <------------------------ Commands ------------------------> */
+
+    Command makeCommand(const InputState& input, double frameTime, std::uint32_t sequence);
+
+    InputState toInput(const Command& command);
+
+    /**
+     * Applies a command to a player, as the server does. Used by the server and by the client's prediction.
+     */
+    void simulate(Player& player, const Command& command, const std::string& map, int mapWidth, int mapHeight);
+
+    /* <------------------------ Serialization ------------------------> */
+
+    class Writer
+    {
+    private:
+        std::string& out;
+
+    public:
+        explicit Writer(std::string& out) : out(out) {}
+
+        void u8(std::uint8_t value) { out += char(value); }
+
+        void u16(std::uint16_t value)
+        {
+            out += char(value & 0xFF);
+            out += char(value >> 8);
+        }
+
+        void u32(std::uint32_t value)
+        {
+            u16(std::uint16_t(value & 0xFFFF));
+            u16(std::uint16_t(value >> 16));
+        }
+
+        void varint(std::uint32_t value) // 7 bits per byte, small values take 1 byte.
+        {
+            while (value >= 0x80)
+            {
+                out += char((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out += char(value);
+        }
+
+        void bytes(std::string_view data) { out.append(data); }
+    };
+
+    class Reader
+    {
+    private:
+        std::string_view data;
+        std::size_t offset = 0;
+        bool failed = false;
+
+    public:
+        explicit Reader(std::string_view data) : data(data) {}
+
+        bool ok() const { return !failed; }
+
+        std::uint8_t u8()
+        {
+            if (offset + 1 > data.size()) { failed = true; return 0; }
+            return std::uint8_t(data[offset++]);
+        }
+
+        std::uint16_t u16()
+        {
+            std::uint16_t low = u8();
+            return std::uint16_t(low | u8() << 8);
+        }
+
+        std::uint32_t u32()
+        {
+            std::uint32_t low = u16();
+            return low | std::uint32_t(u16()) << 16;
+        }
+
+        std::uint32_t varint()
+        {
+            std::uint32_t value = 0;
+            for (int shift = 0; shift < 35; shift += 7)
+            {
+                std::uint8_t byte = u8();
+                value |= std::uint32_t(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            failed = true;
+            return 0;
+        }
+
+        std::string_view bytes(std::size_t count)
+        {
+            if (offset + count > data.size()) { failed = true; return {}; }
+            std::string_view result = data.substr(offset, count);
+            offset += count;
+            return result;
+        }
+    };
+
+    /**
+     * @brief Splits a byte stream into messages.
+     */
+    class MessageBuffer
+    {
+    private:
+        std::string data;
+        std::size_t readOffset = 0;     // Start of the first message not taken yet.
+        bool malformed = false;         // Whether a length didn't fit in LENGTH_BYTES. Nothing is taken after it.
+
+    public:
+        /* <------------------------ Getters ------------------------> */
+
+        /**
+         * @return The bytes received and not taken yet.
+         */
+        std::size_t getBufferedBytes() const { return data.size() - readOffset; }
+
+        /**
+         * @return True if the stream can't be framed anymore, so the connection should be closed.
+         */
+        bool isMalformed() const { return malformed; }
+
+        /* <------------------------ Methods ------------------------> */
+
+        /**
+         * @brief Appends received bytes, dropping the messages already taken.
+         */
+        void append(const char* bytes, int count);
+
+        /**
+         * Takes the next complete message.
+         *
+         * @param type Receives the type of the message.
+         * @param payload Receives the payload. Valid until the next append().
+         * @return False if no complete message was received yet, or the stream is malformed.
+         */
+        bool next(MessageType& type, std::string_view& payload);
+    };
+
+    /**
+     * Starts a message in a buffer.
+     *
+     * @return The offset of the message, to be passed to endMessage().
+     */
+    std::size_t beginMessage(std::string& out, MessageType type);
+
+    /**
+     * Writes the length of a message started with beginMessage(). A message longer than MAX_MESSAGE_SIZE
+     * can't be framed, so it is removed from the buffer instead of being sent with a wrapped length.
+     *
+     * @return False if the message was too long and was removed.
+     */
+    bool endMessage(std::string& out, std::size_t start);
+
+    /**
+     * Encodes a world as a delta from a baseline the receiver has: [tick: u32][baseline tick: u32][changes].
+     *
+     * @param baseline The baseline. A default constructed world (tick 0) encodes the whole world.
+     * @param current The world to encode.
+     * @param out Receives the encoded world.
+     */
+    void encodeDelta(const WorldState& baseline, const WorldState& current, std::string& out);
+
+    /**
+     * Decodes a world encoded by encodeDelta().
+     *
+     * @param baseline The baseline the world was encoded against, found by its tick.
+     * @param tick The tick of the encoded world.
+     * @param reader The encoded world, past the ticks.
+     * @param result Receives the world. Must not be the baseline.
+     * @return False if the data is malformed.
+     */
+    bool decodeDelta(const WorldState& baseline, std::uint32_t tick, Reader& reader, WorldState& result);
+} // namespace Net
+
+#endif // NET_PROTOCOL_HPP
@@ -12,7 +12,11 @@
 #define OBJECTIVE_HPP
 
 #include <stdlib.h>
+#include <cstdint>
 #include <random>
+#include <string>
+#include "freeCellIndex.hpp"
+#include "glyphs.hpp"
 
 /**
  * @class Objective
@@ -27,6 +31,7 @@ private:
     double x = 0;
     double y = 0;
     char tile = 'X';
+    std::mt19937 generator = std::mt19937(std::random_device{}());
 
 public:
     Objective() {}
@@ -69,26 +74,39 @@ public:
         tile = newTile;
     }
 
+    void seed(std::uint32_t seed)
+    {
+        generator.seed(seed);
+    }
+
     /* <------------------------ Methods ------------------------> */
 
     /**
-     * Randomizes the position of the objective within the game map.
+     * Moves the objective to a random empty cell of the game map that the player can reach, away from the
+     * player, in O(1) (see FreeCellIndex::sample()).
      * 
-     * @param mapWidth The width of the game map.
-     * @param mapHeight The height of the game map.
-     * @param map The game map.
+     * @param freeCells The empty cells of the game map.
+     * @param connectivity The components of the game map.
+     * @param playerX The x coordinate of the player.
+     * @param playerY The y coordinate of the player.
+     * @param minDistance The smallest distance to the player, when the map has room for it.
      */
-    void randomizePosition(int mapWidth, int mapHeight, const std::string& map);
+    void randomizePosition(const FreeCellIndex& freeCells, const ConnectivityIndex& connectivity, double playerX, double playerY, double minDistance = 8.0);
 
     /**
      * Randomizes the wall tile based on the ray distance.
      * 
      * It also creates artefacts on the screen tiles to make the scene look more scary.
      * 
+     * The tile is a hash of the column and the frame instead of a draw from a random generator, so it has no
+     * state nor branches and is safe to call from several threads.
+     * 
      * @param wallTile The wall tile to be randomized.
      * @param rayDistance The distance of the ray.
+     * @param column The screen column of the tile.
+     * @param frame The number of the current frame.
      */
-    static void randomizeWallTile(wchar_t& wallTile, double rayDistance);
+    static void randomizeWallTile(Glyph& wallTile, double rayDistance, int column, std::uint32_t frame);
 };
 
 #endif // OBJECTIVE_HPP
\ No newline at end of file
@@ -0,0 +1,66 @@
+/**
+ * @file parallel.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Helpers to split work across threads.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * Calls a function for every index in [0, count), spread across all the hardware threads.
+ *
+ * The threads take the indices one at a time, so uneven work is balanced. The call returns when all the
+ * indices are done. The function must be safe to call concurrently for different indices. A call made from
+ * inside another parallel loop (e.g. a session built on a worker of the server) runs on the calling thread,
+ * so the threads aren't multiplied.
+ *
+ * @param count The number of indices.
+ * @param function The function called with each index.
+ */
+inline thread_local bool insideParallelFor = false;   // Whether the thread is running a parallelFor() loop.
+
+template <typename Function>
+void parallelFor(int count, Function&& function)
+{
+    if (insideParallelFor)
+    {
+        for (int i = 0; i < count; ++i) function(i);
+        return;
+    }
+
+    const int threadCount = std::min<int>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::atomic<int> nextIndex{0};
+
+    auto worker = [&]() {
+        insideParallelFor = true;
+        for (int i = nextIndex++; i < count; i = nextIndex++)
+        {
+            function(i);
+        }
+        insideParallelFor = false;
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();   // The calling thread works too
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+#endif // PARALLEL_HPP
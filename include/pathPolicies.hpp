@@ -0,0 +1,105 @@
+/**
+ * @file pathPolicies.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief The movement rules and heuristics of the pathfinder.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef PATH_POLICIES_HPP
+#define PATH_POLICIES_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace AStar
+{
+    /**
+     * A path cost in fixed point. A straight step costs STRAIGHT_COST and a diagonal one DIAGONAL_COST, so
+     * 577 / 408 stands for the square root of 2 (off by 1 in a million) and every cost is an exact integer:
+     * the searches add and compare them without rounding, and give the same paths on every machine. Paths
+     * of up to 7 million steps fit.
+     */
+    using Cost = std::uint32_t;
+
+    constexpr Cost STRAIGHT_COST = 408;
+    constexpr Cost DIAGONAL_COST = 577;
+
+    /* <------------------------ Heuristics ------------------------> */
+
+    // Each one estimates the cost between two cells dx and dy apart, and never overestimates it for the
+    // movements listed
+
+    struct Octile       // Any movement. The exact cost on an empty map with diagonals.
+    {
+        static Cost estimate(int dx, int dy)
+        {
+            dx = std::abs(dx);
+            dy = std::abs(dy);
+            return STRAIGHT_COST * Cost(std::max(dx, dy)) + (DIAGONAL_COST - STRAIGHT_COST) * Cost(std::min(dx, dy));
+        }
+    };
+
+    struct Manhattan    // Only FourWay. The exact cost on an empty map without diagonals.
+    {
+        static Cost estimate(int dx, int dy) { return STRAIGHT_COST * Cost(std::abs(dx) + std::abs(dy)); }
+    };
+
+    struct Chebyshev    // Any movement. Weaker than Octile, as if diagonals were as cheap as straight steps.
+    {
+        static Cost estimate(int dx, int dy) { return STRAIGHT_COST * Cost(std::max(std::abs(dx), std::abs(dy))); }
+    };
+
+    /* <------------------------ Movements ------------------------> */
+
+    // The steps a path can take from a cell, as offsets, with the straight ones first
+
+    struct FourWay
+    {
+        static constexpr int COUNT = 4;
+        static constexpr int OFFSETS_X[COUNT] = { 1, -1, 0, 0 };
+        static constexpr int OFFSETS_Y[COUNT] = { 0, 0, 1, -1 };
+        static constexpr bool CUTS_CORNERS = true;      // No diagonals, so no corners to cut.
+    };
+
+    struct EightWay     // Diagonal steps can slip between two walls touching at a corner.
+    {
+        static constexpr int COUNT = 8;
+        static constexpr int OFFSETS_X[COUNT] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+        static constexpr int OFFSETS_Y[COUNT] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+        static constexpr bool CUTS_CORNERS = true;
+    };
+
+    struct EightWayNoCorners    // Diagonal steps need both cells beside them free.
+    {
+        static constexpr int COUNT = 8;
+        static constexpr int OFFSETS_X[COUNT] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+        static constexpr int OFFSETS_Y[COUNT] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+        static constexpr bool CUTS_CORNERS = false;
+    };
+
+    /**
+     * @brief The movements a Pathfinder can search with, chosen at runtime.
+     */
+    enum class Movement : std::uint8_t
+    {
+        FOUR_WAY,
+        EIGHT_WAY,
+        EIGHT_WAY_NO_CORNERS,
+    };
+
+    /**
+     * @brief The heuristics a Pathfinder can search with, chosen at runtime.
+     */
+    enum class Heuristic : std::uint8_t
+    {
+        OCTILE,
+        MANHATTAN,
+        CHEBYSHEV,
+    };
+} // namespace AStar
+
+#endif // PATH_POLICIES_HPP
@@ -12,8 +12,11 @@
 #define PLAYER_HPP
 
 #include <iostream>
+#include <chrono>
+#include <random>
 #include "ray.hpp"
 #include "shot.hpp"
+#include "input.hpp"
 #include "constants.hpp"
 
 /**
@@ -48,6 +51,9 @@ private:
     double speed = 4.0f;
     double rotationSpeed = 10.0f;
     std::vector<Shot> shots;    // The shots fired by the player.   
+    std::chrono::high_resolution_clock::time_point lastShotTime = std::chrono::high_resolution_clock::now();
+    std::minstd_rand generator; // Spreads the shots.
+    std::uint32_t nextShotId = 0;
 
     /**
      * @brief Fix player's position floating point imprecision
@@ -103,7 +109,7 @@ public:
         return FOV;
     }
 
-    std::vector<Shot> getShots() const
+    const std::vector<Shot>& getShots() const
     {
         return shots;
     }
@@ -140,6 +146,11 @@ public:
         FOV = newFOV;
     }
 
+    void seed(std::uint32_t seed)
+    {
+        generator.seed(seed);
+    }
+
     /* <------------------------ Methods ------------------------> */
 
     /**
@@ -158,6 +169,19 @@ public:
      */
     void rotate(Direction direction, double deltaTime);
 
+    /**
+     * Moves and rotates the player as requested by the input, undoing the movement if it ends in a wall.
+     * 
+     * The multiplayer server and the client's prediction both use it, so they agree on the result.
+     * 
+     * @param input The actions requested. Only the movement and the turning are used.
+     * @param deltaTime The time elapsed since the last frame.
+     * @param map The game map.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     */
+    void applyMovement(const InputState& input, double deltaTime, const std::string& map, int mapWidth, int mapHeight);
+
     /**
      * @brief Shoots a projectile.
      * 
@@ -175,8 +199,9 @@ public:
      * @param map The game map represented as a string.
      * @param mapWidth The width of the game map.
      * @param deltaTime The time elapsed since the last update.
+     * @param hitWalls If set, receives the cells of the walls the shots hit.
      */
-    void updateShots(const std::string& map, int mapWidth, double deltaTime);
+    void updateShots(const std::string& map, int mapWidth, double deltaTime, std::vector<int>* hitWalls = nullptr);
 
     /**
      * Checks if the player is at the specified position.
@@ -193,7 +218,12 @@ public:
     /**
      * @brief Updates the player's tile based on its angle.
      */
-    void updateTile();
+    void updateTile() { tile = tileForAngle(angle); }
+
+    /**
+     * @return The tile showing a player looking at an angle on the map ('>', '^', '<' or 'v').
+     */
+    static char tileForAngle(double angle);
 
     /**
      * @brief Increases the field of view (FOV) of the player.
@@ -29,9 +29,47 @@ private:
     double angle = 0.0f;
     double distance = 0.0f;
     double maxDepth = 16.0f;
+    double lodDistance = 16.0f;     // Distance from which the ray steps at farStep instead of 0.1.
+    double farStep = 0.1f;
     bool hitWall = false;
     bool hitObjective = false;
     bool hitBoundary = false;
+    int hitCell = -1;               // The index of the wall cell hit, -1 outside the map.
+    double hitFraction = 0.0;       // Where the wall was hit along its face, from 0 to 1.
+
+    /**
+     * @return The increment of the distance in the next step of the ray.
+     */
+    double nextStep() const { return distance < lodDistance ? 0.1 : farStep; }
+
+    /**
+     * Checks if the ray hits something in a map cell and updates the hit flags.
+     * 
+     * The direction is the one the caster already computed: cos(angle) and -sin(angle), since the y-axis of
+     * the map points down. The hits then need no trigonometry.
+     * 
+     * @return True if the ray stops at the cell.
+     */
+    bool hitsCell(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY, int mapWidth, int mapHeight, const std::string& map,
+                  const Objective& objective, bool testObjective);
+
+    /**
+     * Computes where the ray enters a cell along the face it crosses, from the exact intersection of the ray
+     * with the sides of the cell rather than the point the march stopped at.
+     */
+    double computeHitFraction(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY) const;
+
+    /**
+     * Casts 4 rays at once using AVX2. The CPU must support it.
+     */
+    static void castPacketAVX2(Ray* rays, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                               bool testObjective);
+
+    /**
+     * Casts 2 rays at once using SSE2.
+     */
+    static void castPacketSSE2(Ray* rays, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                               bool testObjective);
 
 public:
     Ray() {}
@@ -48,12 +86,20 @@ public:
 
     double getMaxDepth() const { return maxDepth; }
 
+    double getLodDistance() const { return lodDistance; }
+
+    double getFarStep() const { return farStep; }
+
     bool getHitWall() const { return hitWall; }
 
     bool getHitObjective() const { return hitObjective; }
 
     bool getHitBoundary() const { return hitBoundary; }
 
+    int getHitCell() const { return hitCell; }
+
+    double getHitFraction() const { return hitFraction; }
+
     /* <------------------------ Setters ------------------------> */
 
     void setAngle(double newAngle) { angle = newAngle; }
@@ -62,12 +108,26 @@ public:
 
     void setMaxDepth(double newMaxDepth) { maxDepth = newMaxDepth; }
 
+    /**
+     * Sets the level of detail of the ray: past a distance it marches with coarser steps.
+     * 
+     * @param newLodDistance The distance from which the coarser step is used.
+     * @param newFarStep The step used past newLodDistance.
+     */
+    void setLevelOfDetail(double newLodDistance, double newFarStep)
+    {
+        lodDistance = newLodDistance;
+        farStep = newFarStep;
+    }
+
     void setHitWall(bool newHitWall) { hitWall = newHitWall; }
 
     void setHitObjective(bool newHitObjective) { hitObjective = newHitObjective; }
 
     void setHitBoundary(bool newHitBoundary) { hitBoundary = newHitBoundary; }
 
+    void setHitFraction(double newHitFraction) { hitFraction = newHitFraction; }
+
     /* <------------------------ Methods ------------------------> */
 
     /**
@@ -79,8 +139,29 @@ public:
      * @param mapHeight The height of the map.
      * @param map The map containing the game environment.
      * @param objective The objective of the game.
+     * @param testObjective Whether the ray can hit the objective. False skips the test when the objective is known to be hidden.
      */
-    void castRay(double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective);
+    void castRay(double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                 bool testObjective = true);
+
+    /**
+     * Casts several rays from the player's position, with the same results as calling castRay on each one.
+     * 
+     * Neighbouring rays are traced together in SIMD packets (4 rays with AVX2 or 2 with SSE2, chosen by the
+     * CPU features at runtime). Rays that aren't fresh or have different max depths are traced one by one.
+     * 
+     * @param rays The rays to cast.
+     * @param count The number of rays.
+     * @param playerX The x-coordinate of the player's position.
+     * @param playerY The y-coordinate of the player's position.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     * @param map The map containing the game environment.
+     * @param objective The objective of the game.
+     * @param testObjective Whether the rays can hit the objective. False skips the test when the objective is known to be hidden.
+     */
+    static void castRays(Ray* rays, int count, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, 
+                         const Objective& objective, bool testObjective = true);
 
     /**
      * This function is deprecated.
@@ -100,12 +181,32 @@ public:
     /**
      * Verifies if the ray hits a boundary of a cell in the game map.
      * 
+     * It doesn't allocate nor use sqrt, acos or trigonometry, since it runs once per column every frame.
+     * 
      * @param mapX The map cell's x-coordinate.
      * @param mapY The map cell's y-coordinate.
      * @param playerX The x-coordinate of the player's position.
      * @param playerY The y-coordinate of the player's position.
+     * @param dirX The x-component of the ray's direction, cos(angle).
+     * @param dirY The y-component of the ray's direction on the map, -sin(angle).
+     */
+    void verifyBoundary(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY);
+
+    /**
+     * Takes the hit of another ray: its distance, the cell, where on its face and what was hit. The ray keeps
+     * its own angle, depth and level of detail.
+     * 
+     * @param other The ray whose hit is copied.
      */
-    void verifyBoundary(int mapX, int mapY, double playerX, double playerY);
+    void copyHit(const Ray& other)
+    {
+        distance = other.distance;
+        hitWall = other.hitWall;
+        hitObjective = other.hitObjective;
+        hitBoundary = other.hitBoundary;
+        hitCell = other.hitCell;
+        hitFraction = other.hitFraction;
+    }
 
     /**
      * Fixes the fish-eye effect caused by the player's perspective.
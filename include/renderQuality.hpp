@@ -0,0 +1,102 @@
+/**
+ * @file renderQuality.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief RenderQuality class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef RENDER_QUALITY_HPP
+#define RENDER_QUALITY_HPP
+
+/**
+ * @struct QualityLevel
+ * @brief The settings used to cast the rays of the 3D scene.
+ */
+struct QualityLevel
+{
+    int columnStride;       // A ray is cast every columnStride columns, the others are interpolated.
+    double lodDistance;     // Distance from which the rays march with farStep.
+    double farStep;
+    double fogDistance;     // Rays stop at this distance, everything past it is fog.
+};
+
+/**
+ * @class RenderQuality
+ * @brief Adapts the quality of the 3D scene to a target frame time.
+ *
+ * When the frames take longer than the target, the quality is lowered one level at a time: far rays step
+ * coarser, then only every other column is cast, then the fog gets closer. When the frames are comfortably
+ * under the target for a while, the quality goes back up. After each change the level is kept for a cooldown,
+ * so the average frame time shows the effect of the new level before the next change, in either direction.
+ * Without a target the best level is always used.
+ */
+class RenderQuality
+{
+private:
+    static constexpr int LEVEL_COUNT = 4;
+    static constexpr QualityLevel LEVELS[LEVEL_COUNT] = {
+        { 1, 16.0, 0.1, 16.0 },     // Full quality
+        { 1, 8.0, 0.2, 16.0 },      // Coarse far rays
+        { 2, 8.0, 0.2, 16.0 },      // Half the columns
+        { 2, 6.0, 0.3, 12.0 },      // Closer fog
+    };
+
+    double targetFrameTime = 0.0;   // In seconds. 0 disables the adaptation.
+    double averageFrameTime = 0.0;
+    double maxFogDistance = 16.0;
+    int level = 0;
+    int framesUnderBudget = 0;      // Consecutive frames with spare time, used to raise the quality.
+    int cooldownFrames = 0;         // Frames left before the level can change again.
+
+public:
+    RenderQuality() {}
+
+    ~RenderQuality() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getLevel() const { return level; }
+
+    double getAverageFrameTime() const { return averageFrameTime; }
+
+    /**
+     * @return The settings of the current level, with the fog capped by setMaxFogDistance.
+     */
+    QualityLevel getCurrent() const
+    {
+        QualityLevel current = LEVELS[level];
+        if (current.fogDistance > maxFogDistance)   current.fogDistance = maxFogDistance;
+        if (current.lodDistance > maxFogDistance)   current.lodDistance = maxFogDistance;
+        return current;
+    }
+
+    /* <------------------------ Setters ------------------------> */
+
+    /**
+     * @param fps The target frames per second. 0 disables the adaptation.
+     */
+    void setTargetFps(double fps)
+    {
+        targetFrameTime = fps > 0 ? 1.0 / fps : 0.0;
+        if (targetFrameTime == 0.0) level = 0;
+    }
+
+    /**
+     * @param distance The farthest distance visible at any level.
+     */
+    void setMaxFogDistance(double distance) { maxFogDistance = distance; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Updates the quality level with the duration of the last frame.
+     *
+     * @param frameTime The duration of the last frame, in seconds.
+     */
+    void update(double frameTime);
+};
+
+#endif // RENDER_QUALITY_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file scheduler.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief WorkStealingScheduler class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingScheduler
+ * @brief A pool of threads running submitted tasks, each thread with its own queue.
+ *
+ * A worker runs the newest task of its own queue (still hot in its cache) and, when the queue is empty,
+ * steals the oldest task of another worker. Tasks submitted from outside the pool are spread round-robin
+ * across the queues; tasks submitted by a task go to the queue of its worker. The queues are short and
+ * guarded by a mutex each, so the workers only contend when stealing.
+ */
+class WorkStealingScheduler
+{
+private:
+    using Task = std::function<void()>;
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;                 // Signaled when a task is queued or the pool stops.
+    std::condition_variable idle;                   // Signaled when the last pending task ends.
+    std::atomic<int> queuedTasks{0};                // Tasks waiting in the queues.
+    std::atomic<int> pendingTasks{0};               // Tasks queued or running.
+    std::atomic<unsigned> nextQueue{0};             // Round-robin queue of the tasks submitted from outside.
+    bool stopping = false;                          // Guarded by sleepMutex.
+
+    static thread_local int workerIndex;            // Index of the worker running on this thread, or -1.
+
+    /* <------------------------ Methods ------------------------> */
+
+    bool popOwn(int index, Task& task);
+
+    bool steal(int thief, Task& task);
+
+    void workerLoop(int index);
+
+public:
+    /**
+     * Starts the worker threads.
+     *
+     * @param threadCount The number of workers. 0 uses one per hardware thread.
+     */
+    explicit WorkStealingScheduler(int threadCount = 0);
+
+    /**
+     * @brief Runs the queued tasks and stops the workers.
+     */
+    ~WorkStealingScheduler();
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getThreadCount() const { return int(threads.size()); }
+
+    /**
+     * @return The index of the worker running the calling thread, in [0, getThreadCount()), or -1 if the
+     * thread isn't a worker.
+     */
+    static int currentWorker() { return workerIndex; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Queues a task to be run by a worker.
+     *
+     * @param task The task.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Waits until all the submitted tasks have run, including the tasks they submitted.
+     *
+     * Must not be called from a task.
+     */
+    void waitIdle();
+};
+
+#endif // SCHEDULER_HPP
@@ -0,0 +1,145 @@
+/**
+ * @file server.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief SessionServer class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "game.hpp"
+#include "glyphs.hpp"
+#include "input.hpp"
+#include "localSocket.hpp"
+#include "maps.hpp"
+#include "scheduler.hpp"
+
+/**
+ * @class SessionServer
+ * @brief Hosts many independent games in one process, without a console.
+ *
+ * Every session has its own map, player, objective and random generators. The sessions are ticked at a
+ * fixed rate as tasks of a work-stealing scheduler, each on its own deadline: a session is submitted again
+ * when its next tick is due and its previous one has ended, so a slow session delays only its own ticks
+ * instead of holding back the others.
+ *
+ * Clients connect to a local socket and are attached to the first free session. A client sends the keys it
+ * presses as bytes (w/a/s/d move, j/l turn, space shoots, q zooms, e/m/p toggle the FOV, the map and the
+ * path, x detaches) and receives every frame as UTF-8 text, preceded by the escape sequence that moves the
+ * cursor home, so a terminal shows it in place.
+ */
+class SessionServer
+{
+public:
+    struct Config
+    {
+        int sessionCount = 1;
+        double tickRate = 30.0;                         // Ticks per second.
+        int threadCount = 0;                            // Scheduler workers. 0 uses one per hardware thread.
+        std::string socketPath = "ascii-shooter.sock";
+        double reportInterval = 5.0;                    // Seconds between the latency reports. 0 disables them.
+        double duration = 0.0;                          // Seconds to run. 0 runs until the process is killed.
+        std::uint32_t seed = 1;                         // Session i is seeded with seed + 2 * i.
+        std::function<void(Game&)> configureGame;       // Applies the game options to every session, if set.
+        MapData map = Maps::defaultMap();               // The map of every session.
+    };
+
+private:
+    struct Session
+    {
+        explicit Session(const MapData& map) : game(map) {}
+
+        Game game;
+        std::vector<Glyph> screen;
+        std::string frame;                              // UTF-8 frame being sent to the client.
+        std::size_t frameOffset = 0;                    // Bytes of the frame already sent.
+        LocalSocket::Handle client = LocalSocket::INVALID;
+        InputState input;                               // The keys received in the current tick.
+
+        // Only touched by the main thread while the session is idle, and by its tick while it is busy
+        std::atomic<bool> busy{false};                  // A tick is queued or running.
+        std::chrono::steady_clock::time_point releaseTime;      // When the next tick is due.
+        std::chrono::steady_clock::time_point previousRelease;  // When the last tick was due.
+
+        // Tick latency: from the tick's release time to the end of the session's work, in microseconds
+        std::mutex latencyMutex;                        // Guards the latencies, read by the reports.
+        std::vector<double> latencies;                  // Since the last report.
+        double maxLatency = 0.0;
+    };
+
+    Config config;
+    std::vector<std::unique_ptr<Session>> sessions;
+    std::chrono::steady_clock::duration period{};
+    std::atomic<int> attachedClients{0};
+    std::vector<LocalSocket::Handle> waitingClients;    // Accepted while the free sessions were busy.
+    std::mutex tickMutex;
+    std::condition_variable tickEnded;                  // Signaled when a session ends a tick.
+    bool tickEndedFlag = false;                         // Guarded by tickMutex.
+    WorkStealingScheduler scheduler;
+    LocalSocket::Handle listener = LocalSocket::INVALID;
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Attaches the pending clients to free idle sessions. Clients are dropped only if every session has a
+     * client; if the free sessions are busy, they wait for one of them to end its tick.
+     */
+    void acceptClients();
+
+    /**
+     * Reads the key bytes of the session's client into its input state.
+     *
+     * @param session The session.
+     */
+    void readClient(Session& session);
+
+    /**
+     * Encodes the screen of the session and sends as much of it as the socket takes. A frame isn't replaced
+     * until it is fully sent, so a slow client skips frames instead of receiving broken ones.
+     *
+     * @param session The session.
+     */
+    void sendFrame(Session& session);
+
+    /**
+     * Advances, renders and sends a session, records its latency and schedules its next tick. An overrun
+     * tick delays the next one instead of making the session catch up in a burst.
+     *
+     * @param session The session.
+     */
+    void tick(Session& session);
+
+    /**
+     * @brief Prints the tick latency of the sessions since the last report and clears it.
+     */
+    void report();
+
+    void detach(Session& session);
+
+public:
+    explicit SessionServer(const Config& config);
+
+    ~SessionServer();
+
+    /**
+     * @brief Ticks the sessions until the configured duration ends.
+     *
+     * @return False if the socket couldn't be opened.
+     */
+    bool run();
+};
+
+#endif // SERVER_HPP
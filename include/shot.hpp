@@ -12,6 +12,7 @@
 #define SHOT_HPP
 
 #include <cmath>
+#include <cstdint>
 
 struct Shot // Represents a shot fired by the player.
 {
@@ -19,6 +20,7 @@ struct Shot // Represents a shot fired by the player.
     double y;
     double angle;
     double speed;
+    std::uint32_t id = 0;   // Unique among the shots of a player.
 
     Shot(double x, double y, double angle, double speed) : x(x), y(y), angle(angle), speed(speed) {}
 
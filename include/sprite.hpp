@@ -0,0 +1,95 @@
+/**
+ * @file sprite.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Sprite struct and SpriteRenderer class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SPRITE_HPP
+#define SPRITE_HPP
+
+#include <utility>
+#include <vector>
+#include "glyphs.hpp"
+
+struct Sprite // A round billboard in the world, always facing the camera.
+{
+    double x;
+    double y;
+    double radius;      // In world units (a map cell is 1 unit wide and 1 unit tall).
+    double elevation;   // Height of the center relative to the eyes, in world units. Negative is below.
+};
+
+/**
+ * @class SpriteRenderer
+ * @brief Draws sprites over the 3D scene, hidden by the walls in front of them.
+ *
+ * The wall pass writes the distance of each column to the depth buffer. The sprites are then projected
+ * with the same camera as the rays, sorted from the farthest to the closest and drawn column by column,
+ * skipping the columns where a wall is closer than the sprite. The cost doesn't depend on the map, so no
+ * ray is cast per sprite.
+ */
+class SpriteRenderer
+{
+private:
+    std::vector<Sprite> sprites;
+    std::vector<double> depthBuffer;            // Distance of the wall of each column.
+    std::vector<std::pair<double, int>> order;  // (distance, sprite index), sorted to draw back to front.
+    int screenWidth;
+    int screenHeight;
+
+public:
+    static constexpr int MAX_SPRITES = 1024;
+
+    SpriteRenderer(int screenWidth, int screenHeight);
+
+    ~SpriteRenderer() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    int getSpriteCount() const { return int(sprites.size()); }
+
+    /* <------------------------ Setters ------------------------> */
+
+    /**
+     * Sets the distance of the wall drawn at a column.
+     *
+     * @param x The screen column.
+     * @param distance The distance of the wall.
+     */
+    void setDepth(int x, double distance) { depthBuffer[x] = distance; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * @brief Removes all the sprites. Must be called at the start of every frame.
+     */
+    void clear() { sprites.clear(); }
+
+    /**
+     * Adds a sprite to be drawn in this frame. Sprites past MAX_SPRITES are ignored.
+     *
+     * @param sprite The sprite.
+     */
+    void add(const Sprite& sprite)
+    {
+        if (sprites.size() < MAX_SPRITES) sprites.push_back(sprite);
+    }
+
+    /**
+     * Draws the sprites on the screen.
+     *
+     * @param screen The screen buffer.
+     * @param cameraX The x-coordinate of the player.
+     * @param cameraY The y-coordinate of the player.
+     * @param cameraAngle The view angle of the player, in radians.
+     * @param fov The field of view of the player, in radians.
+     * @param maxDistance Sprites farther than this aren't drawn.
+     */
+    void render(Glyph* screen, double cameraX, double cameraY, double cameraAngle, double fov, double maxDistance);
+};
+
+#endif // SPRITE_HPP
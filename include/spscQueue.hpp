@@ -0,0 +1,73 @@
+/**
+ * @file spscQueue.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief SpscQueue class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscQueue
+ * @brief A bounded lock-free queue between one producer thread and one consumer thread.
+ *
+ * The items live in a ring buffer. The producer only writes the tail and the consumer only writes the head,
+ * each on a cache line of its own, so neither ever waits for the other: a push or a pop is a copy and two
+ * atomic operations.
+ *
+ * @tparam T The type of the items.
+ * @tparam Capacity The most items the queue holds. Must be a power of 2.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity must be a power of 2");
+
+private:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> head{0};   // The next item to pop. Written by the consumer.
+    alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};   // The next slot to push to. Written by the producer.
+    alignas(CACHE_LINE) std::array<T, Capacity> items;
+
+public:
+    /**
+     * Adds an item. Only called by the producer.
+     *
+     * @return False if the queue is full.
+     */
+    bool push(const T& item)
+    {
+        const std::size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == Capacity) return false;
+
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, std::memory_order_release);     // Publishes the item
+        return true;
+    }
+
+    /**
+     * Takes the oldest item. Only called by the consumer.
+     *
+     * @return False if the queue is empty.
+     */
+    bool pop(T& item)
+    {
+        const std::size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) return false;
+
+        item = items[position & (Capacity - 1)];
+        head.store(position + 1, std::memory_order_release);     // Frees the slot
+        return true;
+    }
+};
+
+#endif // SPSC_QUEUE_HPP
@@ -0,0 +1,121 @@
+/**
+ * @file trace.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Frame tracer header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class FrameTracer
+ * @brief Records begin and end events of the stages of the game loop.
+ *
+ * Tracing is opt-in. When enabled, the events are stored in a buffer allocated up front, so recording
+ * an event never allocates. The buffer is written as a Chrome Trace Event JSON file when the tracer is
+ * flushed, which can be loaded in chrome://tracing or https://ui.perfetto.dev.
+ */
+class FrameTracer
+{
+private:
+    struct Event
+    {
+        const char* name;       // Must point to a string literal, only the pointer is stored.
+        char phase;             // 'B' for begin, 'E' for end, 'C' for counter.
+        std::int64_t timestamp; // Nanoseconds since the tracer was enabled.
+        std::int64_t value;     // Only used by counters.
+    };
+
+    std::vector<Event> events;
+    std::string outputPath;
+    std::chrono::steady_clock::time_point startTime;
+    std::size_t droppedEvents = 0;  // Events that didn't fit in the buffer.
+    std::size_t openEvents = 0;     // Recorded begins not ended yet, each keeping room for its end.
+    std::size_t droppedOpen = 0;    // Dropped begins not ended yet, whose ends are dropped too.
+    bool enabled = false;
+
+    void record(const char* name, char phase, std::int64_t value = 0);
+
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 22;   // ~4M events, enough for several minutes.
+
+    FrameTracer() {}
+
+    ~FrameTracer() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    bool isEnabled() const { return enabled; }
+
+    std::size_t getDroppedEvents() const { return droppedEvents; }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Enables the tracer and preallocates the event buffer.
+     *
+     * @param path The path of the JSON file written by flush().
+     * @param capacity The maximum number of events recorded. Events past it are dropped, and a begin is only
+     * recorded if its end fits too, so every recorded stage is closed.
+     */
+    void enable(const std::string& path, std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Records the beginning of a stage. Does nothing if the tracer is disabled.
+     *
+     * @param name The name of the stage. Must be a string literal.
+     */
+    void begin(const char* name) { if (enabled) record(name, 'B'); }
+
+    /**
+     * Records the end of a stage. Does nothing if the tracer is disabled.
+     *
+     * @param name The name of the stage. Must be the same passed to begin().
+     */
+    void end(const char* name) { if (enabled) record(name, 'E'); }
+
+    /**
+     * Records the value of a counter, shown as a graph in the trace viewer. Does nothing if the tracer is disabled.
+     *
+     * @param name The name of the counter. Must be a string literal.
+     * @param value The value of the counter.
+     */
+    void counter(const char* name, std::int64_t value) { if (enabled) record(name, 'C', value); }
+
+    /**
+     * Writes the recorded events to the output file in the Chrome Trace Event format.
+     *
+     * @return True if the file was written, false if the tracer is disabled or the file couldn't be opened.
+     */
+    bool flush() const;
+};
+
+/**
+ * @class TraceScope
+ * @brief Records a begin event on construction and the matching end event on destruction.
+ */
+class TraceScope
+{
+private:
+    FrameTracer& tracer;
+    const char* name;
+
+public:
+    TraceScope(FrameTracer& tracer, const char* name) : tracer(tracer), name(name) { tracer.begin(name); }
+
+    ~TraceScope() { tracer.end(name); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif // TRACE_HPP
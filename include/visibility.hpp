@@ -0,0 +1,204 @@
+/**
+ * @file visibility.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief VisibilityTable class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef VISIBILITY_HPP
+#define VISIBILITY_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class VisibilityTable
+ * @brief Potentially visible set (PVS) of every cell of the map.
+ *
+ * For each cell, stores which cells around it can be seen from somewhere inside it. Nothing is visible past
+ * the render distance, so each cell only keeps a bitset of the (2R + 1) x (2R + 1) window centered on it,
+ * where R is the render distance. The memory grows with the map, not with its square.
+ *
+ * The table is conservative: a cell marked hidden can't be reached by any ray of the game from the viewer's
+ * cell, so the objective's test can be skipped for it. The walls are shrunk by TOLERANCE, which covers the
+ * rays slipping between their steps and the distance from anywhere in the viewer's cell to the nearest of a
+ * grid of points in it. From each of those points a single shadowcast marks the cells that any ray reaches
+ * past the shrunk walls (see sweep()).
+ *
+ * Every bitset is computed when the map is loaded, the rows spread across the threads, so a query is a
+ * single bit read without locks. The table never changes after that, so the games of a server that load
+ * the same map share it (see share()).
+ */
+class VisibilityTable
+{
+private:
+    friend class VisibilityOverlay;
+
+    /**
+     * @brief Memory reused by the sweeps of a thread.
+     */
+    struct Scratch
+    {
+        std::vector<std::pair<double, double>> shadows;     // Sorted and apart, in pseudo-angles.
+        std::vector<double> cornerAngles;                   // The pseudo-angle of each corner of the window's cells.
+        std::vector<std::uint8_t> walls;                    // Whether each cell of the window and its border is a wall.
+        std::vector<std::uint8_t> state;                    // The ring of each cell of the window until it's QUEUED, then OPEN.
+        std::vector<int> open;                              // The open cells of the last ring.
+        std::vector<int> nextOpen;                          // The open cells of the current ring.
+        std::vector<int> pending;                           // The cells of the current ring waiting to be tested.
+    };
+
+    enum : std::uint8_t { OPEN = 253, QUEUED = 254, BORDER = 255 };   // Past the rings, which stop at 252.
+
+    std::string map;            // The map the cells are computed from. Only '#' blocks the sight.
+    std::vector<std::uint64_t> bits;
+    int mapWidth = 0;
+    int mapHeight = 0;
+    int radius = 0;             // The render distance, in cells.
+    int windowSize = 0;         // 2 * radius + 1
+    int wordsPerCell = 0;
+    std::vector<std::uint8_t> rings;    // The ring of each cell of the window, or BORDER around it and past the render distance. windowSize + 2 wide.
+
+    /**
+     * @return True if a cell is a wall. The outside of the map is, since the rays stop there.
+     */
+    bool isWall(int x, int y) const { return x < 0 || x >= mapWidth || y < 0 || y >= mapHeight || map[y * mapWidth + x] == '#'; }
+
+    /**
+     * Marks the cells of a cell's window that are seen from a point, through the walls shrunk by TOLERANCE.
+     *
+     * @param pointX The x-coordinate of the point, inside the cell.
+     * @param pointY The y-coordinate of the point, inside the cell.
+     * @param x The x-coordinate of the cell.
+     * @param y The y-coordinate of the cell.
+     * @param cellBits The bitset of the cell.
+     * @param scratch The memory of the calling thread.
+     */
+    void sweep(double pointX, double pointY, int x, int y, std::uint64_t* cellBits, Scratch& scratch) const;
+
+    /**
+     * Computes the visibility bitset of a cell.
+     */
+    void computeCell(int x, int y, Scratch& scratch);
+
+public:
+    VisibilityTable() {}
+
+    ~VisibilityTable() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::size_t getMemoryUsage() const { return bits.size() * sizeof(std::uint64_t); }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Computes the bitsets of every cell of a map, in parallel.
+     *
+     * @param map The game map. Only '#' blocks the sight.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     * @param renderDistance The farthest distance anything is drawn.
+     */
+    void build(const std::string& map, int mapWidth, int mapHeight, double renderDistance);
+
+    /**
+     * Returns the table of a map, made by the first caller and shared by everyone holding it. The table is
+     * released with its last holder.
+     *
+     * @param map The game map. Only '#' blocks the sight.
+     * @param mapWidth The width of the map.
+     * @param mapHeight The height of the map.
+     * @param renderDistance The farthest distance anything is drawn.
+     * @return The table, never null.
+     */
+    static std::shared_ptr<const VisibilityTable> share(const std::string& map, int mapWidth, int mapHeight, double renderDistance);
+
+    /**
+     * Checks if a cell can be seen from another one in O(1).
+     *
+     * @param fromX The x-coordinate of the viewer's cell.
+     * @param fromY The y-coordinate of the viewer's cell.
+     * @param toX The x-coordinate of the target cell.
+     * @param toY The y-coordinate of the target cell.
+     * @return False if the target is certainly hidden or out of the render distance, true otherwise.
+     */
+    bool isVisible(int fromX, int fromY, int toX, int toY) const
+    {
+        int dx = toX - fromX + radius;
+        int dy = toY - fromY + radius;
+
+        if (bits.empty())                                                                       return true;    // No map, cull nothing
+        if (fromX < 0 || fromX >= mapWidth || fromY < 0 || fromY >= mapHeight)                  return true;
+        if (dx < 0 || dx >= windowSize || dy < 0 || dy >= windowSize)                           return false;
+
+        int bit = dy * windowSize + dx;
+        return bits[std::size_t(fromY * mapWidth + fromX) * wordsPerCell + bit / 64] >> (bit % 64) & 1;
+    }
+};
+
+/**
+ * @class VisibilityOverlay
+ * @brief A game's view of a shared VisibilityTable, with the edits of its own map.
+ *
+ * A line of sight through an opened wall joins two cells within the render distance of it, so only the
+ * pairs around it can change. They're all marked as visible, which never hides anything, in copies of the
+ * bitsets of the cells around it kept by the overlay: an edit costs the window around the cell, never the
+ * map, and the other games keep the table as it is. Walls added later are left visible, for the same reason.
+ */
+class VisibilityOverlay
+{
+private:
+    std::shared_ptr<const VisibilityTable> table;
+    std::unordered_map<int, std::vector<std::uint64_t>> editedCells;   // The bitsets changed by the edits, by cell.
+
+public:
+    VisibilityOverlay() {}
+
+    ~VisibilityOverlay() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::size_t getEditedCells() const { return editedCells.size(); }
+
+    /* <------------------------ Setters ------------------------> */
+
+    /**
+     * Shows a table, without any edit.
+     */
+    void setTable(std::shared_ptr<const VisibilityTable> table)
+    {
+        this->table = std::move(table);
+        editedCells.clear();
+    }
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Updates the visibility after a wall of the map was removed.
+     *
+     * @param x The x-coordinate of the opened cell.
+     * @param y The y-coordinate of the opened cell.
+     */
+    void openCell(int x, int y);
+
+    /**
+     * Checks if a cell can be seen from another one, like VisibilityTable::isVisible() but with the edits.
+     *
+     * @param fromX The x-coordinate of the viewer's cell.
+     * @param fromY The y-coordinate of the viewer's cell.
+     * @param toX The x-coordinate of the target cell.
+     * @param toY The y-coordinate of the target cell.
+     * @return False if the target is certainly hidden or out of the render distance, true otherwise.
+     */
+    bool isVisible(int fromX, int fromY, int toX, int toY) const;
+};
+
+#endif // VISIBILITY_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file wallTextures.hpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief WallTextures class header file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#ifndef WALL_TEXTURES_HPP
+#define WALL_TEXTURES_HPP
+
+#include <cstdint>
+#include <vector>
+#include "glyphs.hpp"
+
+/**
+ * @class WallTextures
+ * @brief The textures of the walls, with their mip levels, in one atlas.
+ *
+ * A texel is how deep the wall is carved there (a mortar joint, a crack), from 0 (the face of the wall) to
+ * DEPTHS - 1. The glyph of a pixel is a lookup in a table by the shade of its column and the depth of its
+ * texel, so texturing adds no branch to the drawing of a column.
+ *
+ * Each texture is SIZE x SIZE texels, followed by its mip levels, each half as wide as the previous one and
+ * made of the averages of its 2 x 2 blocks, down to 1 x 1. The levels are stored column by column, since a
+ * wall is drawn one screen column at a time: a column reads consecutive bytes. Everything is built once, in
+ * the constructor, and takes a few KiB.
+ */
+class WallTextures
+{
+public:
+    enum class Type : std::uint8_t
+    {
+        BRICK,              // The walls, and the outside of the map.
+        DOOR,
+        CRACKED,            // The destructible walls.
+        COUNT,
+    };
+
+    static constexpr int SIZE = 16;
+    static constexpr int LEVELS = 5;    // 16, 8, 4, 2 and 1 texels wide.
+    static constexpr int SHADES = 5;    // Nothing, then from the lightest to the darkest glyph.
+    static constexpr int DEPTHS = 4;
+
+private:
+    std::vector<std::uint8_t> texels;
+    int offsets[int(Type::COUNT)][LEVELS];      // Where each level of each texture starts in texels.
+    Glyph shades[SHADES][DEPTHS];
+
+public:
+    /**
+     * @brief Builds the textures and their mip levels.
+     */
+    WallTextures();
+
+    ~WallTextures() {}
+
+    /* <------------------------ Getters ------------------------> */
+
+    std::size_t getMemoryUsage() const { return texels.size(); }
+
+    /**
+     * @param shade The shade of a column, from 0 (nothing) to SHADES - 1 (the darkest glyph).
+     * @return The glyphs of the column by the depth of the texel.
+     */
+    const Glyph* getShades(int shade) const { return shades[shade]; }
+
+    /**
+     * Returns a column of a texture.
+     *
+     * @param type The texture.
+     * @param level The mip level (see selectLevel()).
+     * @param u Where the column is along the wall, from 0 to 1.
+     * @return The SIZE >> level texels of the column, from the top.
+     */
+    const std::uint8_t* getColumn(Type type, int level, double u) const;
+
+    /* <------------------------ Methods ------------------------> */
+
+    /**
+     * Chooses the most detailed mip level with no more rows than a wall on the screen, so each row of the
+     * screen shows a different texel and distant walls read the averages instead of skipping texels.
+     *
+     * @param wallHeight The height of the wall on the screen, in rows.
+     * @return The mip level.
+     */
+    static int selectLevel(int wallHeight)
+    {
+        int level = 0;
+        while (level < LEVELS - 1 && (SIZE >> level) > wallHeight) level++;
+        return level;
+    }
+};
+
+#endif // WALL_TEXTURES_HPP
@@ -3,143 +3,152 @@
  * @author Felipe Passarela (felipepassarela11@gmail.com)
  * @brief A* pathfinding algorithm implementation file.
  * @date 2024-02-14
- * 
+ *
  * @copyright Copyright (c) 2024
- * 
+ *
  */
 
 #include "AStar.hpp"
 #include <algorithm>
-#include <cmath>
+#include <chrono>
 
 using namespace AStar;
-using namespace AStar::Utils;
 
-std::vector<std::pair<int, int>> AStar::findPath(int startX, int startY, int endX, int endY, int mapWidth, int mapHeight, const std::string& map)
+void Pathfinder::beginSearch(std::size_t cellCount)
 {
-    NodeList openList;
-    NodeList closedList;
-
-    NodePtr startNode = std::make_shared<Node>(startX, startY, 0, heuristic(startX, startY, endX, endY), nullptr);
-    NodePtr endNode = std::make_shared<Node>(endX, endY, 0, 0, nullptr);
-
-    openList.push_back(startNode);
-
-    while (!openList.empty())
+    if (cells.size() != cellCount)
     {
-        NodePtr currentNode = openList.front();
-
-        if (*currentNode == *endNode)
-        {
-            return reconstructPath(currentNode);
-        }
-
-        closedList.push_back(currentNode);
-        openList.erase(std::remove(openList.begin(), openList.end(), currentNode), openList.end());
-
-        auto neighbours = findNeighbours(currentNode, mapWidth, mapHeight, map);
-        for (auto& neighbour : neighbours)
-        {
-            evaluateNeighbour(neighbour, currentNode, endNode, openList, closedList);
-        }
-
-        std::sort(openList.begin(), openList.end(), [](const NodePtr& a, const NodePtr& b) { return a->fCost < b->fCost; });
+        cells.assign(cellCount, Cell());
+        generation = 0;
     }
 
-    return {};
-}
-
-/* <----------------------------------------------- Utils -----------------------------------------------> */
-
-double AStar::Utils::heuristic(int startX, int startY, int endX, int endY)
-{
-    // Manhattan distance
-    // return std::abs(endX - startX) + std::abs(endY - startY);
-
-    // Euclidean distance
-    return std::sqrt(std::pow(endX - startX, 2) + std::pow(endY - startY, 2));
-
-    // Diagonal distance
-    // return std::max(std::abs(endX - startX), std::abs(endY - startY));
-
-    // Octile distance
-    // int dx = std::abs(endX - startX);
-    // int dy = std::abs(endY - startY);
-    // return std::max(dx, dy) + (std::sqrt(2) - 1) * std::min(dx, dy);
+    // When the stamp wraps around, the old stamps could match again
+    if (++generation == 0)
+    {
+        for (Cell& cell : cells) cell.generation = 0;
+        generation = 1;
+    }
 
-    // Chebyshev distance
-    // return std::max(std::abs(endX - startX), std::abs(endY - startY));
+    openList.clear();
+    stats = Stats();
 }
 
-bool AStar::Utils::isNodeInList(const NodePtr node, const NodeList& list)
+Pathfinder::Kernel Pathfinder::findKernel(Movement movement, Heuristic heuristic)
 {
-    for (auto& n : list)
-    {
-        if (*n == *node) return true;
-    }
-    return false;
+    // Manhattan overestimates with diagonals, so it only has the 4-way kernel
+    static constexpr Kernel KERNELS[3][3] = {
+        { &Pathfinder::search<FourWay, Octile>, &Pathfinder::search<FourWay, Manhattan>, &Pathfinder::search<FourWay, Chebyshev> },
+        { &Pathfinder::search<EightWay, Octile>, nullptr, &Pathfinder::search<EightWay, Chebyshev> },
+        { &Pathfinder::search<EightWayNoCorners, Octile>, nullptr, &Pathfinder::search<EightWayNoCorners, Chebyshev> },
+    };
+
+    return KERNELS[int(movement)][int(heuristic)];
 }
 
-std::vector<std::pair<int, int>> AStar::Utils::reconstructPath(NodePtr endNode)
+bool Pathfinder::setPolicy(Movement movement, Heuristic heuristic)
 {
-    std::vector<std::pair<int, int>> path;
-    NodePtr currentNode = endNode;
+    Kernel newKernel = findKernel(movement, heuristic);
+    if (!newKernel) return false;
 
-    while (currentNode->parent != nullptr)
-    {
-        path.push_back(std::make_pair(currentNode->x, currentNode->y));
-        currentNode = currentNode->parent;
-    }
-
-    std::reverse(path.begin(), path.end());
-    return path;
+    this->movement = movement;
+    this->heuristic = heuristic;
+    kernel = newKernel;
+    return true;
 }
 
-NodeList AStar::Utils::findNeighbours(const NodePtr node, int mapWidth, int mapHeight, const std::string& map)
+template <typename MovementPolicy, typename HeuristicPolicy>
+bool Pathfinder::search(int start, int end, int mapWidth, int mapHeight, const std::string& map)
 {
-    NodeList neighbours;
+    // Makes the open list a min-heap of the f cost. Ties go to the deepest node, which is closer to the end
+    auto isMoreExpensive = [](const OpenEntry& a, const OpenEntry& b) {
+        return a.fCost != b.fCost ? a.fCost > b.fCost : a.gCost < b.gCost;
+    };
+
+    const int endX = end % mapWidth;
+    const int endY = end / mapWidth;
+    const bool useLandmarks = landmarks && landmarks->getMapWidth() == mapWidth && landmarks->getMapHeight() == mapHeight;
+    auto estimate = [&](int cell, int x, int y) {
+        const Cost policyEstimate = HeuristicPolicy::estimate(endX - x, endY - y);
+        return useLandmarks ? std::max(policyEstimate, landmarks->lowerBound(cell, end)) : policyEstimate;
+    };
+    auto isFree = [&](int x, int y) {
+        return x >= 0 && x < mapWidth && y >= 0 && y < mapHeight && map[y * mapWidth + x] == ' ';
+    };
+
+    cells[start] = { 0, -1, generation, false };
+    openList.push_back({ estimate(start, start % mapWidth, start / mapWidth), 0, start });
 
-    for (int dx = -1; dx <= 1; ++dx)
+    while (!openList.empty())
     {
-        for (int dy = -1; dy <= 1; ++dy)
-        {
-            if (dx == 0 && dy == 0) continue;
+        std::pop_heap(openList.begin(), openList.end(), isMoreExpensive);
+        const OpenEntry current = openList.back();
+        openList.pop_back();
 
-            int x = node->x + dx;
-            int y = node->y + dy;
+        Cell& currentCell = cells[current.cell];
+        if (currentCell.closed || current.gCost > currentCell.gCost) continue;  // Stale, a cheaper entry came first
 
-            if (x < 0 || x >= mapWidth || y < 0 || y >= mapHeight)  continue;
-            if (map[y * mapWidth + x] != ' ')                       continue;
+        currentCell.closed = true;
+        stats.expandedNodes++;
+        if (current.cell == end) return true;
 
-            neighbours.push_back(std::make_shared<Node>(x, y, 0, 0, nullptr));
+        const int x = current.cell % mapWidth;
+        const int y = current.cell / mapWidth;
+        for (int i = 0; i < MovementPolicy::COUNT; ++i)
+        {
+            const int dx = MovementPolicy::OFFSETS_X[i];
+            const int dy = MovementPolicy::OFFSETS_Y[i];
+            const int neighbourX = x + dx;
+            const int neighbourY = y + dy;
+            if (!isFree(neighbourX, neighbourY)) continue;
+
+            const bool isDiagonal = dx != 0 && dy != 0;
+            if (!MovementPolicy::CUTS_CORNERS && isDiagonal && (!isFree(x + dx, y) || !isFree(x, y + dy))) continue;
+
+            const int neighbour = neighbourY * mapWidth + neighbourX;
+            Cell& cell = cells[neighbour];
+            const Cost gCost = current.gCost + (isDiagonal ? DIAGONAL_COST : STRAIGHT_COST);
+            if (cell.generation == generation && gCost >= cell.gCost) continue;
+
+            cell = { gCost, current.cell, generation, false };    // Opens the cell again if it was closed
+            openList.push_back({ gCost + estimate(neighbour, neighbourX, neighbourY), gCost, neighbour });
+            std::push_heap(openList.begin(), openList.end(), isMoreExpensive);
+            stats.heapPeak = std::max(stats.heapPeak, openList.size());
         }
     }
 
-    return neighbours;
+    return false;
 }
 
-void AStar::Utils::evaluateNeighbour(NodePtr neighbour, NodePtr currentNode, const NodePtr endNode, NodeList& openList, const NodeList& closedList)
+bool Pathfinder::findPath(int startX, int startY, int endX, int endY, int mapWidth, int mapHeight, const std::string& map,
+                          std::vector<std::pair<int, int>>& path)
 {
-    if (isNodeInList(neighbour, closedList)) return;
+    auto startTime = std::chrono::steady_clock::now();
+    path.clear();
 
-    double gCost = currentNode->gCost + heuristic(currentNode->x, currentNode->y, neighbour->x, neighbour->y);
-    bool gCostIsBest = false;
+    if (startX < 0 || startX >= mapWidth || startY < 0 || startY >= mapHeight ||
+        endX < 0 || endX >= mapWidth || endY < 0 || endY >= mapHeight) return false;
 
-    if (!isNodeInList(neighbour, openList))
-    {
-        gCostIsBest = true;
-        neighbour->hCost = heuristic(neighbour->x, neighbour->y, endNode->x, endNode->y);
-        openList.push_back(neighbour);
-    }
-    else if (gCost < neighbour->gCost)
+    const int start = startY * mapWidth + startX;
+    const int end = endY * mapWidth + endX;
+    if (connectivity && connectivity->getMapWidth() == mapWidth && connectivity->getMapHeight() == mapHeight &&
+        connectivity->isOpen(start) && !connectivity->connected(start, end))
     {
-        gCostIsBest = true;
+        stats = Stats();
+        return false;
     }
 
-    if (gCostIsBest)
+    beginSearch(std::size_t(mapWidth) * mapHeight);
+    const bool found = (this->*kernel)(start, end, mapWidth, mapHeight, map);
+
+    if (found)
     {
-        neighbour->parent = currentNode;
-        neighbour->gCost = gCost;
-        neighbour->fCost = neighbour->gCost + neighbour->hCost;
+        for (int cell = end; cell != start; cell = cells[cell].parent)
+        {
+            path.push_back(std::make_pair(cell % mapWidth, cell / mapWidth));
+        }
+        std::reverse(path.begin(), path.end());
     }
+
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return found;
 }
@@ -0,0 +1,64 @@
+/**
+ * @file allocationCounter.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief AllocationCounter namespace implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "allocationCounter.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef _DEBUG
+
+static thread_local std::size_t allocationCount = 0;     // Plain, each thread only counts its own.
+
+void* operator new(std::size_t bytes)
+{
+    allocationCount++;
+    if (bytes == 0) bytes = 1;
+    if (void* p = std::malloc(bytes)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t bytes)
+{
+    return operator new(bytes);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+std::size_t AllocationCounter::count()
+{
+    return allocationCount;
+}
+
+#else
+
+std::size_t AllocationCounter::count()
+{
+    return 0;
+}
+
+#endif // _DEBUG
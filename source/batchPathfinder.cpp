@@ -0,0 +1,192 @@
+/**
+ * @file batchPathfinder.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief BatchPathfinder class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "batchPathfinder.hpp"
+#include "freeCellIndex.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+void PathBatch::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return isReady(); });
+}
+
+BatchPathfinder::BatchPathfinder(WorkStealingScheduler& scheduler) :
+    scheduler(scheduler), pathfinders(scheduler.getThreadCount()) {}
+
+void BatchPathfinder::setLandmarks(const AStar::Landmarks* landmarks)
+{
+    for (AStar::Pathfinder& pathfinder : pathfinders) pathfinder.setLandmarks(landmarks);
+}
+
+void BatchPathfinder::setConnectivity(const ConnectivityIndex* connectivity)
+{
+    for (AStar::Pathfinder& pathfinder : pathfinders) pathfinder.setConnectivity(connectivity);
+}
+
+std::shared_ptr<PathBatch> BatchPathfinder::submit(std::vector<PathQuery> queries, int mapWidth, int mapHeight, const std::string& map)
+{
+    auto batch = std::make_shared<PathBatch>();
+    batch->queries = std::move(queries);
+    batch->paths.resize(batch->queries.size());
+
+    const int queryCount = int(batch->queries.size());
+    const int taskCount = (queryCount + QUERIES_PER_TASK - 1) / QUERIES_PER_TASK;
+    batch->remainingTasks = taskCount;
+
+    for (int task = 0; task < taskCount; ++task)
+    {
+        // The tasks hold the batch, so it lives until they end even if the caller drops it
+        scheduler.submit([this, batch, task, queryCount, mapWidth, mapHeight, &map]() {
+            AStar::Pathfinder& pathfinder = pathfinders[WorkStealingScheduler::currentWorker()];
+
+            std::size_t expandedNodes = 0;
+            const int end = std::min(queryCount, (task + 1) * QUERIES_PER_TASK);
+            for (int i = task * QUERIES_PER_TASK; i < end; ++i)
+            {
+                const PathQuery& query = batch->queries[i];
+                pathfinder.findPath(query.startX, query.startY, query.endX, query.endY, mapWidth, mapHeight, map, batch->paths[i]);
+                expandedNodes += pathfinder.getStats().expandedNodes;
+            }
+            batch->expandedNodes.fetch_add(expandedNodes, std::memory_order_relaxed);
+
+            if (batch->remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                batch->done.notify_all();
+            }
+        });
+    }
+
+    return batch;
+}
+
+std::vector<Path> BatchPathfinder::findPaths(std::vector<PathQuery> queries, int mapWidth, int mapHeight, const std::string& map)
+{
+    std::shared_ptr<PathBatch> batch = submit(std::move(queries), mapWidth, mapHeight, map);
+    batch->wait();
+    return std::move(batch->paths);
+}
+
+void BatchPathfinder::runBenchmark(const MapData& data, int queryCount, int threadCount, std::uint32_t seed)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // The markers aren't walkable for the pathfinder, the game clears them when it loads the map
+    std::string map = data.tiles;
+    for (char& tile : map)
+    {
+        if (tile != '#') tile = ' ';
+    }
+
+    FreeCellIndex freeCells;
+    freeCells.build(map, data.width);
+    if (freeCells.empty()) return;
+
+    std::mt19937 generator(seed);
+    std::vector<PathQuery> queries(queryCount);
+    for (PathQuery& query : queries)
+    {
+        int start = freeCells.sample(generator);
+        int end = freeCells.sample(generator);
+        query = { start % data.width, start / data.width, end % data.width, end / data.width };
+    }
+
+    auto start = Clock::now();
+    AStar::Landmarks landmarks;
+    landmarks.build(map, data.width, data.height);
+    double landmarksTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // The same queries on one thread, with the octile distance alone and then with the landmarks
+    // Unreachable queries return at once in every run
+    ConnectivityIndex connectivity;
+    connectivity.build(map, data.width, data.height);
+
+    AStar::Pathfinder pathfinder;
+    pathfinder.setConnectivity(&connectivity);
+    std::vector<Path> serialPaths(queries.size());
+    std::size_t expandedNodes[2] = {};
+    double serialTimes[2] = {};
+    for (int useLandmarks = 0; useLandmarks < 2; ++useLandmarks)
+    {
+        pathfinder.setLandmarks(useLandmarks ? &landmarks : nullptr);
+        start = Clock::now();
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            const PathQuery& query = queries[i];
+            pathfinder.findPath(query.startX, query.startY, query.endX, query.endY, data.width, data.height, map, serialPaths[i]);
+            expandedNodes[useLandmarks] += pathfinder.getStats().expandedNodes;
+        }
+        serialTimes[useLandmarks] = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    WorkStealingScheduler scheduler(threadCount);
+    BatchPathfinder batchPathfinder(scheduler);
+    batchPathfinder.setLandmarks(&landmarks);
+    batchPathfinder.setConnectivity(&connectivity);
+    start = Clock::now();
+    std::shared_ptr<PathBatch> batch = batchPathfinder.submit(queries, data.width, data.height, map);
+    batch->wait();
+    double batchTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    int reached = 0;
+    int mismatches = 0;
+    for (std::size_t i = 0; i < queries.size(); ++i)
+    {
+        const PathQuery& query = queries[i];
+        bool isStart = query.startX == query.endX && query.startY == query.endY;
+        reached += isStart || !batch->getPaths()[i].empty();
+        mismatches += batch->getPaths()[i] != serialPaths[i];
+    }
+
+    const double average = std::max(1, queryCount);
+    std::printf("%d paths on a %dx%d map: %d reachable\n", queryCount, data.width, data.height, reached);
+    std::printf("%d landmarks: built in %.1f ms, %.1f KiB\n", landmarks.getCount(), landmarksTime * 1000.0,
+        landmarks.getMemoryUsage() / 1024.0);
+    std::printf("1 thread, octile distance: %.1f ms (%.0f paths/s), %.0f nodes expanded on average\n",
+        serialTimes[0] * 1000.0, queryCount / serialTimes[0], expandedNodes[0] / average);
+    std::printf("1 thread, landmarks: %.1f ms (%.0f paths/s), %.0f nodes expanded on average\n",
+        serialTimes[1] * 1000.0, queryCount / serialTimes[1], expandedNodes[1] / average);
+    std::printf("%d threads, landmarks: %.1f ms (%.0f paths/s), %d paths differ from the single thread\n", scheduler.getThreadCount(),
+        batchTime * 1000.0, queryCount / batchTime, mismatches);
+
+    // The other kernels of the pathfinder, with the landmarks. Their paths differ, the cost of a step too
+    struct Policy
+    {
+        const char* name;
+        AStar::Movement movement;
+        AStar::Heuristic heuristic;
+    };
+    const Policy policies[] = {
+        { "4-way, Manhattan", AStar::Movement::FOUR_WAY, AStar::Heuristic::MANHATTAN },
+        { "8-way, Chebyshev", AStar::Movement::EIGHT_WAY, AStar::Heuristic::CHEBYSHEV },
+        { "8-way without corner cutting, octile", AStar::Movement::EIGHT_WAY_NO_CORNERS, AStar::Heuristic::OCTILE },
+    };
+    for (const Policy& policy : policies)
+    {
+        pathfinder.setPolicy(policy.movement, policy.heuristic);
+        std::size_t policyNodes = 0;
+        start = Clock::now();
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            const PathQuery& query = queries[i];
+            pathfinder.findPath(query.startX, query.startY, query.endX, query.endY, data.width, data.height, map, serialPaths[i]);
+            policyNodes += pathfinder.getStats().expandedNodes;
+        }
+        double policyTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::printf("1 thread, landmarks, %s: %.1f ms (%.0f paths/s), %.0f nodes expanded on average\n", policy.name,
+            policyTime * 1000.0, queryCount / policyTime, policyNodes / average);
+    }
+    std::fflush(stdout);
+}
@@ -0,0 +1,262 @@
+/**
+ * @file connectivityIndex.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief ConnectivityIndex class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "connectivityIndex.hpp"
+#include <algorithm>
+
+constexpr int MAX_SIDES = 4;    // The most groups of cells around a cell that don't touch each other.
+
+int ConnectivityIndex::newLabel()
+{
+    componentCount++;
+    if (unusedLabels.empty())
+    {
+        members.emplace_back();
+        return int(members.size()) - 1;
+    }
+
+    const int label = unusedLabels.back();
+    unusedLabels.pop_back();
+    return label;
+}
+
+void ConnectivityIndex::releaseLabel(int label)
+{
+    componentCount--;
+    unusedLabels.push_back(label);
+}
+
+void ConnectivityIndex::setLabel(int cell, int label)
+{
+    // The last cell of the old list takes the place of the moved one
+    const int oldLabel = labels[cell];
+    if (oldLabel >= 0)
+    {
+        std::vector<int>& oldMembers = members[oldLabel];
+        const int last = oldMembers.back();
+        oldMembers[memberPositions[cell]] = last;
+        memberPositions[last] = memberPositions[cell];
+        oldMembers.pop_back();
+    }
+
+    labels[cell] = label;
+    if (label >= 0)
+    {
+        memberPositions[cell] = int(members[label].size());
+        members[label].push_back(cell);
+    }
+}
+
+void ConnectivityIndex::relabel(int cell, int label)
+{
+    const int oldLabel = labels[cell];
+    setLabel(cell, label);
+    queue.clear();
+    queue.push_back(cell);
+
+    for (std::size_t i = 0; i < queue.size(); ++i)
+    {
+        forEachNeighbour(queue[i], [&](int neighbour) {
+            if (labels[neighbour] != oldLabel) return;
+
+            setLabel(neighbour, label);
+            queue.push_back(neighbour);
+        });
+    }
+}
+
+void ConnectivityIndex::build(const std::string& map, int mapWidth, int mapHeight)
+{
+    constexpr int UNLABELED = -2;
+
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    labels.assign(map.size(), NO_COMPONENT);
+    members.clear();
+    memberPositions.assign(map.size(), -1);
+    unusedLabels.clear();
+    componentCount = 0;
+    visits.assign(map.size(), 0);
+    owners.assign(map.size(), 0);
+    visit = 0;
+
+    for (std::size_t i = 0; i < map.size(); ++i)
+    {
+        if (map[i] != '#') labels[i] = UNLABELED;
+    }
+
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (labels[i] != UNLABELED) continue;
+
+        relabel(i, newLabel());
+    }
+}
+
+void ConnectivityIndex::open(int cell)
+{
+    if (labels[cell] != NO_COMPONENT) return;
+
+    // The components around the cell, each with one of its cells
+    int around[8];
+    int aroundCells[8];
+    int count = 0;
+    forEachNeighbour(cell, [&](int neighbour) {
+        const int label = labels[neighbour];
+        if (label == NO_COMPONENT || std::find(around, around + count, label) != around + count) return;
+
+        around[count] = label;
+        aroundCells[count] = neighbour;
+        count++;
+    });
+
+    if (count == 0)
+    {
+        setLabel(cell, newLabel());
+        return;
+    }
+
+    // The smaller components join the largest one
+    const int largest = *std::max_element(around, around + count, [this](int a, int b) { return members[a].size() < members[b].size(); });
+    for (int i = 0; i < count; ++i)
+    {
+        if (around[i] == largest) continue;
+
+        relabel(aroundCells[i], largest);
+        releaseLabel(around[i]);
+    }
+
+    setLabel(cell, largest);
+}
+
+void ConnectivityIndex::close(int cell)
+{
+    const int label = labels[cell];
+    if (label == NO_COMPONENT) return;
+
+    setLabel(cell, NO_COMPONENT);
+    if (members[label].empty())
+    {
+        releaseLabel(label);
+        return;
+    }
+
+    // Around the cell, cells next to each other touch, and so do the sides two apart (e.g. the top and the
+    // right), so the cells that touch are grouped: each group is one side
+    int ring[8];
+    int groups[8];
+    const int x = cell % mapWidth;
+    const int y = cell / mapWidth;
+    for (int i = 0; i < 8; ++i)
+    {
+        const int neighbourX = x + OFFSETS_X[i];
+        const int neighbourY = y + OFFSETS_Y[i];
+        const bool inside = neighbourX >= 0 && neighbourX < mapWidth && neighbourY >= 0 && neighbourY < mapHeight;
+        ring[i] = inside && labels[neighbourY * mapWidth + neighbourX] != NO_COMPONENT ? neighbourY * mapWidth + neighbourX : -1;
+        groups[i] = i;
+    }
+
+    auto findGroup = [&](int i) {
+        while (groups[i] != i) i = groups[i];
+        return i;
+    };
+    auto join = [&](int a, int b) {
+        if (ring[a] >= 0 && ring[b] >= 0) groups[findGroup(a)] = findGroup(b);
+    };
+    for (int i = 0; i < 8; ++i)
+    {
+        join(i, (i + 1) % 8);
+        if (i % 2 == 1) join(i, (i + 2) % 8);
+    }
+
+    std::vector<int> sides;
+    for (int i = 0; i < 8; ++i)
+    {
+        if (ring[i] >= 0 && findGroup(i) == i) sides.push_back(ring[i]);
+    }
+
+    if (sides.size() > 1) split(sides);
+}
+
+void ConnectivityIndex::split(const std::vector<int>& sides)
+{
+    const int label = labels[sides[0]];
+    const int sideCount = int(sides.size());
+
+    if (++visit == 0)
+    {
+        std::fill(visits.begin(), visits.end(), 0);
+        visit = 1;
+    }
+
+    // A breadth-first search per side, one cell at a time each. Sides whose searches meet are merged
+    std::vector<int> queues[MAX_SIDES];
+    std::size_t heads[MAX_SIDES] = {};
+    int parents[MAX_SIDES];
+    for (int i = 0; i < sideCount; ++i)
+    {
+        visits[sides[i]] = visit;
+        owners[sides[i]] = std::uint8_t(i);
+        queues[i].push_back(sides[i]);
+        parents[i] = i;
+    }
+
+    auto findSide = [&](int side) {
+        while (parents[side] != side) side = parents[side];
+        return side;
+    };
+    auto isExhausted = [&](int root) {
+        for (int i = 0; i < sideCount; ++i)
+        {
+            if (findSide(i) == root && heads[i] < queues[i].size()) return false;
+        }
+        return true;
+    };
+
+    // Stops when only one side is left: it keeps the label, and the others got new ones when they ran out
+    int unresolved = sideCount;
+    bool separated[MAX_SIDES] = {};
+    while (unresolved > 1)
+    {
+        for (int i = 0; i < sideCount && unresolved > 1; ++i)
+        {
+            if (separated[findSide(i)] || heads[i] == queues[i].size()) continue;
+
+            const int current = queues[i][heads[i]++];
+            forEachNeighbour(current, [&](int neighbour) {
+                if (labels[neighbour] != label) return;
+
+                if (visits[neighbour] != visit)
+                {
+                    visits[neighbour] = visit;
+                    owners[neighbour] = std::uint8_t(i);
+                    queues[i].push_back(neighbour);
+                    return;
+                }
+
+                const int root = findSide(i);
+                const int otherRoot = findSide(owners[neighbour]);
+                if (root == otherRoot) return;
+
+                parents[otherRoot] = root;
+                unresolved--;
+            });
+
+            const int root = findSide(i);
+            if (unresolved > 1 && isExhausted(root))
+            {
+                separated[root] = true;
+                unresolved--;
+
+                relabel(sides[root], newLabel());
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file framePacer.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief FramePacer class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "framePacer.hpp"
+#include <algorithm>
+#include <thread>
+
+double FramePacer::wait(bool idle)
+{
+    const double frameTime = idle ? std::max(idleFrameTime, targetFrameTime) : targetFrameTime;
+    auto now = Clock::now();
+
+    if (frameTime > 0.0)
+    {
+        deadline += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frameTime));
+        if (now > deadline)
+        {
+            missedDeadlines++;
+            deadline = now;
+        }
+        else
+        {
+            auto sleep = deadline - now - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(spinTime));
+            if (sleep > Clock::duration::zero())
+            {
+                std::this_thread::sleep_for(sleep);
+
+                // The spin covers the worst recent oversleep, and shrinks back slowly when the sleeps get precise
+                double overslept = std::chrono::duration<double>(Clock::now() - (now + sleep)).count();
+                spinTime = std::clamp(std::max(overslept * 1.25, spinTime * 0.98), MIN_SPIN_TIME, MAX_SPIN_TIME);
+            }
+            while (Clock::now() < deadline) std::this_thread::yield();
+        }
+        now = Clock::now();
+    }
+    else
+    {
+        deadline = now;
+    }
+
+    double elapsed = std::chrono::duration<double>(now - previousFrame).count();
+    previousFrame = now;
+    frameCount++;
+    return elapsed;
+}
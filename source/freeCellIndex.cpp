@@ -0,0 +1,85 @@
+/**
+ * @file freeCellIndex.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief FreeCellIndex class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "freeCellIndex.hpp"
+
+void FreeCellIndex::build(const std::string& map, int mapWidth)
+{
+    this->mapWidth = mapWidth;
+    cells.clear();
+    positions.assign(map.size(), -1);
+
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (map[i] == '#') continue;
+
+        positions[i] = int(cells.size());
+        cells.push_back(i);
+    }
+}
+
+void FreeCellIndex::add(int cell)
+{
+    if (cell < 0 || cell >= int(positions.size()) || positions[cell] >= 0) return;
+
+    positions[cell] = int(cells.size());
+    cells.push_back(cell);
+}
+
+void FreeCellIndex::remove(int cell)
+{
+    if (!contains(cell)) return;
+
+    // The last cell takes the place of the removed one
+    const int position = positions[cell];
+    const int last = cells.back();
+    cells[position] = last;
+    positions[last] = position;
+    cells.pop_back();
+    positions[cell] = -1;
+}
+
+int FreeCellIndex::sample(std::mt19937& generator) const
+{
+    if (cells.empty()) return -1;
+
+    return cells[std::uniform_int_distribution<std::size_t>(0, cells.size() - 1)(generator)];
+}
+
+int FreeCellIndex::sample(std::mt19937& generator, double x, double y, double minDistance, const ConnectivityIndex* connectivity) const
+{
+    // Drawn from the point's component, so every draw is reachable, unless the point is in none
+    const int origin = int(y) * mapWidth + int(x);
+    if (connectivity && (origin < 0 || origin >= int(positions.size()) || !connectivity->isOpen(origin))) connectivity = nullptr;
+    const std::vector<int>& candidates = connectivity ? connectivity->getCells(connectivity->getComponent(origin)) : cells;
+    if (candidates.empty()) return -1;
+
+    std::uniform_int_distribution<std::size_t> distribution(0, candidates.size() - 1);
+    const double minDistanceSquared = minDistance * minDistance;
+
+    int farthest = -1;
+    double farthestDistanceSquared = -1.0;
+    for (int i = 0; i < MAX_TRIES; ++i)
+    {
+        const int cell = candidates[distribution(generator)];
+        const double dx = cell % mapWidth + 0.5 - x;
+        const double dy = cell / mapWidth + 0.5 - y;
+        const double distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared >= minDistanceSquared) return cell;
+
+        if (distanceSquared > farthestDistanceSquared)
+        {
+            farthest = cell;
+            farthestDistanceSquared = distanceSquared;
+        }
+    }
+
+    return farthest;
+}
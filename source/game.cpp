@@ -10,144 +10,326 @@
 
 #include "game.hpp"
 #include "constants.hpp"
+#include "maps.hpp"
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <cmath>
 #include <random>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
 
-// TODO: Reorganize run function. Maybe move screen buffer and hConsole to main.cpp
 // TODO: Reset the mouse position to the center of the console window.
-// TODO: Refactor renderPlayerShots to use linear algebra to calculate the shot position on the screen
 
-Game::Game() 
+Game::Game() : Game(Maps::defaultMap()) {}
+
+Game::Game(MapData data)
 {
-    map += "##################################################################";
-    map += "#                             #                                  #";
-    map += "#    #    #    ##########     #     #########################    #";
-    map += "#    #    #    #              #                             #    #";
-    map += "#    #    #####################    #####################    #    #";
-    map += "#    #                             #                   #    #    #";
-    map += "#    ###################################     ###########    #    #";
-    map += "#    #              #                        #         #    #    #";
-    map += "#    ##########     #    #    ###########    #    #    #    ######";
-    map += "#    #              #    #    #         #    #    #    #         #";
-    map += "#    #     ##########    #    #####     #    #    #    #    #    #";
-    map += "#    #                   #    #         #    #    #    #    #    #";
-    map += "#    #####################    #     #####    #    #    #    #    #";
-    map += "#                             #              #    #    #    #    #";
-    map += "##########################    ################    #    ######    #";
-    map += "#              #         #    #  X                #    #         #";
-    map += "#    #    #    #    #    #    #    ################    #####     #";
-    map += "#    #    #    #    #    #    #    #              #              #";
-    map += "#    #    #    #    #    #    #    #     ####################    #";
-    map += "#    #    #         #    #    #    #                        #    #";
-    map += "#    #    ################    #    #    ###########    #    #    #";
-    map += "#    #                        #    #    #         #    #    #    #";
-    map += "#    ##########################    #    #    #    #    #    #    #";
-    map += "#    #         #              #    #    #    #    #    #    #    #";
-    map += "#    #    #    ##########     #    #    ######    #    ######    #";
-    map += "#         #                   #  ^ #              #              #";
-    map += "##################################################################";
+    map = std::move(data.tiles);
+    MAP_WIDTH = data.width;
+    MAP_HEIGHT = data.height;
+    editor.load(map, MAP_WIDTH, MAP_HEIGHT);
+    lighting.load(map, MAP_WIDTH, MAP_HEIGHT);
+    freeCells.build(map, MAP_WIDTH);
+    connectivity.build(map, MAP_WIDTH, MAP_HEIGHT);
+
+    rays.resize(SCREEN_WIDTH);
+
+    initialSetup();
 }
 
-void Game::run()
+void Game::update(const InputState& input, double frameTime)
 {
-    initialSetup();
+    frameStartAllocations = AllocationCounter::count();
+    frameStart = std::chrono::steady_clock::now();
+
+    deltaTime = frameTime;
+    if (deltaTime == 0.0) deltaTime = 0.0001;
+
+    // The cost of the frames, not their interval, which includes the pacer's waits
+    quality.update(frameCost);
+
+    applyInput(input);
+    if (client)
+    {
+        // In multiplayer the server owns the shots and the objective
+        TraceScope scope(tracer, "updateClient");
+        client->update(input, deltaTime);
+        syncWithClient();
+    }
+    else
+    {
+        TraceScope scope(tracer, "updateShots");
+        hitWalls.clear();
+        player.updateShots(map, MAP_WIDTH, deltaTime, &hitWalls);
+        for (int cell : hitWalls) editor.destroy(cell);
+    }
+    {
+        TraceScope scope(tracer, "updateLights");
+        lighting.clearDynamicLights();
+        for (const Shot& shot : player.getShots()) lighting.addDynamicLight(shot.x, shot.y);
+        if (client)
+        {
+            for (const auto& [x, y] : client->getShots()) lighting.addDynamicLight(x, y);
+        }
+    }
+    if (showPathToObjective)
+    {
+        TraceScope scope(tracer, "findPathToObjective");
+        findPathToObjective();
+    }
+    if (!client && player.isAtPosition(objective.getX(), objective.getY()))
+    {
+        TraceScope scope(tracer, "randomizePosition");
+        objective.randomizePosition(freeCells, connectivity, player.getX(), player.getY());
+    }
+}
+
+void Game::render(Glyph* screen)
+{
+    {
+        TraceScope scope(tracer, "render3dScene");
+        render3dScene(screen);
+    }
+    {
+        TraceScope scope(tracer, "render2dObjects");
+        render2dObjects(screen);
+    }
+
+    frameCount++;
+    frameCost = std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count();
+    frameAllocations = AllocationCounter::count() - frameStartAllocations;
+    tracer.counter("allocations", frameAllocations);
+    tracer.counter("reusedScenes", reusedScenes);
+}
 
-    wchar_t* screen = new wchar_t[SCREEN_WIDTH * SCREEN_HEIGHT];
+#ifdef _WIN32
+
+void Game::run()
+{
+    std::vector<Glyph> screen(SCREEN_WIDTH * SCREEN_HEIGHT, ' ');
+    std::vector<wchar_t> consoleBuffer(SCREEN_WIDTH * SCREEN_HEIGHT);
     HANDLE hConsole = CreateConsoleScreenBuffer(GENERIC_READ | GENERIC_WRITE, 0, NULL, CONSOLE_TEXTMODE_BUFFER, NULL);
     SetConsoleActiveScreenBuffer(hConsole);
     DWORD dwBytesWritten = 0;
 
-    POINT lastMousePos;
-    GetCursorPos(&lastMousePos);
+    InputThread inputThread;
+    inputThread.start();
+
+    timeBeginPeriod(1);     // Lets the pacer's sleeps end within a millisecond of when they are due
 
-    auto previousTime = std::chrono::high_resolution_clock::now();
+    bool idle = false;
     while (running)
     {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        deltaTime = std::chrono::duration<double>(currentTime - previousTime).count();
-        if (deltaTime == 0.0) deltaTime = 0.0001;
-        previousTime = currentTime;
+        double frameTime;
+        {
+            TraceScope scope(tracer, "waitFrame");
+            frameTime = framePacer.wait(idle);
+        }
 
-        readInput(lastMousePos);
+        TraceScope frameScope(tracer, "frame");
 
-        player.updateShots(map, MAP_WIDTH, deltaTime);
+        InputState input;
+        {
+            TraceScope scope(tracer, "readInput");
+            input = inputThread.poll();
+            tracer.counter("inputLatencyMicroseconds", std::int64_t(inputThread.getLatency() * 1e6));
+        }
 
-        if (showPathToObjective)                                        findPathToObjective();
-        if (player.isAtPosition(objective.getX(), objective.getY()))    objective.randomizePosition(MAP_WIDTH, MAP_HEIGHT, map);
+        update(input, frameTime);
+        render(screen.data());
 
-        render3dScene(screen);
-        render2dObjects(screen);
+        {
+            TraceScope scope(tracer, "writeConsole");
+            Glyphs::toWide(consoleBuffer.data(), screen.data(), SCREEN_WIDTH * SCREEN_HEIGHT);
+            WriteConsoleOutputCharacterW(hConsole, consoleBuffer.data(), SCREEN_WIDTH * SCREEN_HEIGHT, { 0, 0 }, &dwBytesWritten);
+        }
 
-        screen[SCREEN_WIDTH * SCREEN_HEIGHT - 1] = '\0';
-        WriteConsoleOutputCharacterW(hConsole, screen, SCREEN_WIDTH * SCREEN_HEIGHT, { 0, 0 }, &dwBytesWritten);
+        // Nothing to animate but the objective's noise, which is fine at the idle rate
+        idle = !client && input.isEmpty() && player.getShots().empty();
+        tracer.counter("missedDeadlines", framePacer.getMissedDeadlines());
     }
 
-    delete[] screen;
+    inputThread.stop();
+    timeEndPeriod(1);
     CloseHandle(hConsole);
+
+    tracer.flush();
 }
 
-void Game::resetMousePos()
+#endif // _WIN32
+
+void Game::render3dScene(Glyph* screen)
 {
-    POINT p;
-    GetCursorPos(&p);
-    int screenWidth = GetSystemMetrics(SM_CXSCREEN);
-    int screenHeight = GetSystemMetrics(SM_CYSCREEN);
-    if (p.x < screenWidth / 2 - 300 || p.x > screenWidth / 2 + 300)
-        SetCursorPos(screenWidth / 2, screenHeight / 2);
+    const QualityLevel settings = quality.getCurrent();
+    const int stride = settings.columnStride;
+    const int castCount = (SCREEN_WIDTH + stride - 1) / stride;
+
+    bool objectiveVisible = visibility.isVisible(int(player.getX()), int(player.getY()), int(objective.getX()), int(objective.getY()));
+
+    // The hash only rules views out quickly, a match is confirmed field by field
+    const SceneView view = captureView(settings, objectiveVisible);
+    const std::uint64_t viewHash = hashView(view);
+    if (viewHash == sceneHash && view == sceneView)
+    {
+        // The rays and the depth buffer are still the ones of the cached scene
+        std::memcpy(screen, sceneCache.data(), sceneCache.size() * sizeof(Glyph));
+        for (int x = 0; x < SCREEN_WIDTH; x++)
+        {
+            if (rays[x].getHitObjective()) renderScreenByHeight(rays[x], screen, x);
+        }
+
+        reusedScenes++;
+        return;
+    }
+
+    // The cast rays are packed at the start of the buffer, so they are traced together
+    for (int i = 0; i < castCount; i++)
+    {
+        rays[i] = Ray(getColumnAngle(i * stride));
+        rays[i].setMaxDepth(settings.fogDistance);
+        rays[i].setLevelOfDetail(settings.lodDistance, settings.farStep);
+    }
+
+    Ray::castRays(rays.data(), castCount, player.getX(), player.getY(), MAP_WIDTH, MAP_HEIGHT, map, objective, objectiveVisible);
+
+    if (stride > 1) interpolateSkippedColumns(stride);
+
+    for (int x = 0; x < SCREEN_WIDTH; x++)
+    {
+        spriteRenderer.setDepth(x, rays[x].getDistance());
+        renderScreenByHeight(rays[x], screen, x);
+    }
+
+    sceneCache.assign(screen, screen + SCREEN_WIDTH * SCREEN_HEIGHT);
+    sceneView = view;
+    sceneHash = viewHash;
 }
 
-void Game::render3dScene(wchar_t* screen)
+Game::SceneView Game::captureView(const QualityLevel& settings, bool objectiveVisible) const
 {
+    return {
+        player.getX(), player.getY(), player.getAngle(), player.getFOV(),
+        double(settings.columnStride), settings.lodDistance, settings.farStep, settings.fogDistance,
+        objective.getX(), objective.getY(), double(objectiveVisible), double(editor.getVersion()),
+        double(lighting.getVersion()),
+    };
+}
+
+std::uint64_t Game::hashView(const SceneView& view)
+{
+    // SplitMix64 finalizer over the bits of each value. Source: https://prng.di.unimi.it/splitmix64.c
+    std::uint64_t hash = 0;
+    for (double value : view)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash = (hash ^ bits) + 0x9E3779B97F4A7C15;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+        hash = hash ^ (hash >> 31);
+    }
+
+    return hash | 1;
+}
+
+void Game::interpolateSkippedColumns(int stride)
+{
+    // Spread the packed rays to their columns, backwards so none is overwritten before being moved
+    for (int x = (SCREEN_WIDTH - 1) / stride * stride; x > 0; x -= stride)
+    {
+        rays[x] = rays[x / stride];
+    }
+
     for (int x = 0; x < SCREEN_WIDTH; x++)
     {
-        double rayAngle = (player.getAngle() + player.getFOV() / 2.0) - (x / float(SCREEN_WIDTH)) * player.getFOV();
-        Ray ray(rayAngle);
+        if (x % stride == 0) continue;
+
+        const Ray& left = rays[x - x % stride];
+        rays[x] = Ray(getColumnAngle(x));
+        rays[x].setMaxDepth(left.getMaxDepth());
+        rays[x].setLevelOfDetail(left.getLodDistance(), left.getFarStep());
+        rays[x].copyHit(left);
 
-        ray.castRay(player.getX(), player.getY(), MAP_WIDTH, MAP_HEIGHT, map, objective);
-        wchar_t wallTile = createWallTile(ray);
+        int rightX = x - x % stride + stride;
+        if (rightX >= SCREEN_WIDTH) continue;
 
-        renderScreenByHeight(ray, screen, x, wallTile);
+        const Ray& right = rays[rightX];
+        if (left.getHitWall() && right.getHitWall() && !left.getHitBoundary() && !right.getHitBoundary())
+        {
+            double t = double(x % stride) / stride;
+            rays[x].setDistance(left.getDistance() + (right.getDistance() - left.getDistance()) * t);
+
+            // Across the same wall the texture slides between them too. Across different walls it would sweep
+            // through textures neither ray hit, so the column keeps the left ray's fraction
+            if (left.getHitCell() == right.getHitCell())
+            {
+                rays[x].setHitFraction(left.getHitFraction() + (right.getHitFraction() - left.getHitFraction()) * t);
+            }
+        }
     }
 }
 
-void Game::renderScreenByHeight(Ray& ray, wchar_t* screen, int x, wchar_t wallTile)
+void Game::renderScreenByHeight(Ray& ray, Glyph* screen, int x)
 {
     int ceiling = SCREEN_HEIGHT / 2.0 - SCREEN_HEIGHT / ray.getDistance();
     int floor = SCREEN_HEIGHT - ceiling;
+    const int wallTop = std::clamp(ceiling + 1, 0, SCREEN_HEIGHT);
+    const int wallBottom = std::clamp(floor + 1, 0, SCREEN_HEIGHT);
+
+    for (int y = 0; y < wallTop; y++) screen[y * SCREEN_WIDTH + x] = ' ';
 
-    for (int y = 0; y < SCREEN_HEIGHT; y++)
+    const int shade = ray.getHitWall() ? Lighting::lightShade(getWallShade(ray), lighting.getLevel(ray.getHitCell()), WallTextures::SHADES - 1) : 0;
+    const int wallHeight = floor - ceiling;
+    if (shade > 0 && wallHeight > 0)
     {
-        if (y <= ceiling)                       screen[y * SCREEN_WIDTH + x] = ' ';
-        else if (y > ceiling && y <= floor)     screen[y * SCREEN_WIDTH + x] = wallTile;
-        else if (y > floor)
+        WallTextures::Type type = WallTextures::Type::BRICK;
+        if (ray.getHitCell() >= 0)
         {
-            double floorDistance = 1.0 - (y - SCREEN_HEIGHT / 2.0) / (SCREEN_HEIGHT / 2.0);
-            if (floorDistance < 0.25)           screen[y * SCREEN_WIDTH + x] = '#';
-            else if (floorDistance < 0.5)       screen[y * SCREEN_WIDTH + x] = 'x';
-            else if (floorDistance < 0.75)      screen[y * SCREEN_WIDTH + x] = '.';
-            else                                screen[y * SCREEN_WIDTH + x] = ' ';
+            const MapEditor::CellKind kind = editor.getKind(ray.getHitCell());
+            if (kind == MapEditor::CellKind::DOOR)                  type = WallTextures::Type::DOOR;
+            else if (kind == MapEditor::CellKind::DESTRUCTIBLE)     type = WallTextures::Type::CRACKED;
         }
+
+        const int level = WallTextures::selectLevel(wallHeight);
+        const std::uint8_t* texels = wallTextures.getColumn(type, level, ray.getHitFraction());
+        const Glyph* glyphs = wallTextures.getShades(shade);
+
+        // The row of the texture in 16.16 fixed point, so a row costs an add and a shift
+        const int step = (WallTextures::SIZE >> level << 16) / wallHeight;
+        int v = (wallTop - ceiling - 1) * step;
+        for (int y = wallTop; y < wallBottom; y++, v += step) screen[y * SCREEN_WIDTH + x] = glyphs[texels[v >> 16]];
+    }
+    else
+    {
+        const Glyph wallTile = createWallTile(ray, x);
+        for (int y = wallTop; y < wallBottom; y++) screen[y * SCREEN_WIDTH + x] = wallTile;
+    }
+
+    // A row of the floor at a distance d is where a wall at d ends, so it shows the cell d along the ray
+    const double dirX = cos(ray.getAngle());
+    const double dirY = -sin(ray.getAngle());
+    for (int y = wallBottom; y < SCREEN_HEIGHT; y++)
+    {
+        double floorDistance = 1.0 - (y - SCREEN_HEIGHT / 2.0) / (SCREEN_HEIGHT / 2.0);
+        const int band = std::min(Lighting::FLOOR_BANDS - 1, int(floorDistance * Lighting::FLOOR_BANDS));
+        const double distance = SCREEN_HEIGHT / (y - SCREEN_HEIGHT / 2.0);
+        const int level = lighting.getLevel(int(player.getX() + distance * dirX), int(player.getY() + distance * dirY));
+        screen[y * SCREEN_WIDTH + x] = lighting.getFloorGlyphs(band)[level];
     }
 }
 
-wchar_t Game::createWallTile(Ray& ray) const
+Glyph Game::createWallTile(Ray& ray, int column) const
 {
-    wchar_t wallTile = ' ';
+    Glyph wallTile = ' ';
     
     if (ray.getHitWall())
     {
-        if (ray.getDistance() < 0.75)                           wallTile = 0x2593;  // Closest
-        else if (ray.getDistance() < ray.getMaxDepth() / 3.5)   wallTile = 0x2588;
-        else if (ray.getDistance() < ray.getMaxDepth() / 3.0)   wallTile = 0x2593;
-        else if (ray.getDistance() < ray.getMaxDepth() / 2.0)   wallTile = 0x2592;
-        else if (ray.getDistance() < ray.getMaxDepth())         wallTile = 0x2591;  // Farthest
+        wallTile = wallTextures.getShades(getWallShade(ray))[0];
     }
     else if (ray.getHitObjective())
     {
-        objective.randomizeWallTile(wallTile, ray.getDistance());
+        objective.randomizeWallTile(wallTile, ray.getDistance(), column, frameCount);
     }
 
     if (ray.getHitBoundary())                       wallTile = ' ';    
@@ -156,6 +338,17 @@ wchar_t Game::createWallTile(Ray& ray) const
     return wallTile;
 }
 
+int Game::getWallShade(const Ray& ray) const
+{
+    if (ray.getHitBoundary() || ray.getDistance() >= ray.getMaxDepth()) return 0;
+
+    if (ray.getDistance() < 0.75)                           return 3;   // Closest
+    else if (ray.getDistance() < ray.getMaxDepth() / 3.5)   return 4;
+    else if (ray.getDistance() < ray.getMaxDepth() / 3.0)   return 3;
+    else if (ray.getDistance() < ray.getMaxDepth() / 2.0)   return 2;
+    else                                                    return 1;   // Farthest
+}
+
 void Game::initialSetup()
 {
     for (int i = 0; i < MAP_HEIGHT; ++i)
@@ -180,149 +373,130 @@ void Game::initialSetup()
             }
         }
     }
+
+    minimap.markDirty();
+    visibility.setTable(VisibilityTable::share(map, MAP_WIDTH, MAP_HEIGHT, Ray().getMaxDepth()));
+    // With every door open, no path is shorter than on the real map, so the bounds hold through the edits
+    landmarks = AStar::Landmarks::share(editor.getOpenMap(), MAP_WIDTH, MAP_HEIGHT);
+    pathfinder.setLandmarks(landmarks.get());
+    pathfinder.setConnectivity(&connectivity);
+
+    editor.addListener([this](int cell, char, char newTile) { onMapEdit(cell, newTile); });
+}
+
+void Game::onMapEdit(int cell, char newTile)
+{
+    const bool opened = newTile != '#';
+    const int x = cell % MAP_WIDTH;
+    const int y = cell / MAP_WIDTH;
+
+    if (opened)
+    {
+        freeCells.add(cell);
+        connectivity.open(cell);
+
+        visibility.openCell(x, y);     // The shared table stays as it is for the other games
+    }
+    else
+    {
+        freeCells.remove(cell);
+        connectivity.close(cell);
+    }
+    minimap.updateCell(map, MAP_WIDTH, MAP_HEIGHT, cell);
+    lighting.updateAround(cell);
+
+    // An opened cell can shorten the path, a closed one only matters if the path crosses it
+    if (opened || std::find(pathToObjective.begin(), pathToObjective.end(), std::make_pair(x, y)) != pathToObjective.end())
+    {
+        previousPathX = -1;
+        previousPathY = -1;
+    }
+
+    if (!opened && int(objective.getX()) == x && int(objective.getY()) == y)
+    {
+        objective.randomizePosition(freeCells, connectivity, player.getX(), player.getY());
+    }
 }
 
-void Game::readInput(POINT& lastMousePos)
+void Game::applyInput(const InputState& input)
 {
-    // Calculate the change in the X-coordinate of the mouse pointer
-    int mouseDeltaX = 0;
-    POINT currentMousePos;
-    GetCursorPos(&currentMousePos);
-    mouseDeltaX = currentMousePos.x - lastMousePos.x;
-    lastMousePos = currentMousePos;
-    resetMousePos();
-
-    movePlayer(mouseDeltaX);
-
-    // This is necessary to toggle buttons
-    static bool wasMPressed = false;
-    static bool wasEPressed = false;
-    static bool wasPPressed = false;
-
-    bool isMPressed = GetAsyncKeyState('M') & 0x8000;
-    bool isEPressed = GetAsyncKeyState('E') & 0x8000;
-    bool isPPressed = GetAsyncKeyState('P') & 0x8000;
-
-    if (!wasEPressed && isEPressed)
+    if (!client) movePlayer(input);     // Otherwise predicted by the client
+
+    if (input.toggleFOV)
     {
         // Toggle the player's FOV (initial or 2*PI)
         if (player.getFOV() == player.getInitialFOV())  player.setFOV(2 * PI);
         else                                            player.setFOV(player.getInitialFOV());
     }
-    if (!wasMPressed && isMPressed)             showMap = !showMap;
-    if (!wasPPressed && isPPressed && showMap)  showPathToObjective = !showPathToObjective; // Only show path if map is shown
-    if (GetAsyncKeyState('Q') & 0x8000)         player.increaseFOV(deltaTime);
-    if (GetAsyncKeyState(VK_SPACE) & 0x8000)    player.shoot();
-    if (GetAsyncKeyState(VK_ESCAPE) & 0x8000)   running = false;
-
-    wasMPressed = isMPressed;
-    wasEPressed = isEPressed;
-    wasPPressed = isPPressed;
+    if (input.toggleMap)                showMap = !showMap;
+    if (input.togglePath && showMap)    showPathToObjective = !showPathToObjective; // Only show path if map is shown
+    if (input.zoom)                     player.increaseFOV(deltaTime);
+    if (input.shoot && !client)         player.shoot();
+    if (input.use && !client)           editor.toggleDoorsAround(player.getX(), player.getY());
+    if (input.quit)                     running = false;
 }
 
-void Game::movePlayer(int mouseDeltaX)
+void Game::movePlayer(const InputState& input)
 {
-    double lastPlayerX = player.getX();
-    double lastPlayerY = player.getY();
-
-    if (GetAsyncKeyState('W') & 0x8000)     player.move(Direction::UP, deltaTime);
-    if (GetAsyncKeyState('S') & 0x8000)     player.move(Direction::DOWN, deltaTime);
-    if (GetAsyncKeyState('A') & 0x8000)     player.move(Direction::LEFT, deltaTime);
-    if (GetAsyncKeyState('D') & 0x8000)     player.move(Direction::RIGHT, deltaTime);
-    if (mouseDeltaX < 0)                    player.rotate(Direction::LEFT, deltaTime);
-    if (mouseDeltaX > 0)                    player.rotate(Direction::RIGHT, deltaTime);
-
-    int playerX = int(player.getX());
-    int playerY = int(player.getY());
+    player.applyMovement(input, deltaTime, map, MAP_WIDTH, MAP_HEIGHT);
+}
 
-    if (playerX <= 0 || playerX >= MAP_WIDTH ||
-        playerY <= 0 || playerY >= MAP_HEIGHT ||
-        map[playerY * MAP_WIDTH + playerX] == '#')
-    {
-        player.setX(lastPlayerX);
-        player.setY(lastPlayerY);
-    }
+void Game::syncWithClient()
+{
+    const Player& predicted = client->getPlayer();
+    player.setX(predicted.getX());
+    player.setY(predicted.getY());
+    player.setAngle(predicted.getAngle());
+    player.updateTile();
+
+    objective.setX(client->getObjectiveX());
+    objective.setY(client->getObjectiveY());
 }
 
-void Game::renderPlayerShots(wchar_t* screen)
+void Game::renderPlayerShots(Glyph* screen)
 {
-    for (Shot& shot : player.getShots()) 
+    const double SHOT_RADIUS = 0.06;
+    const double SHOT_ELEVATION = -0.15;    // Below the eyes, as if shot from the hip
+    const double PLAYER_RADIUS = 0.25;
+    const double PLAYER_ELEVATION = -0.1;
+
+    // Sprites in cells hidden from the player are culled before being projected
+    auto addSprite = [&](double x, double y, double radius, double elevation) {
+        if (visibility.isVisible(int(player.getX()), int(player.getY()), int(x), int(y))) spriteRenderer.add({ x, y, radius, elevation });
+    };
+
+    spriteRenderer.clear();
+    for (const Shot& shot : player.getShots()) 
     {
-        const int MAX_RADIUS = 15;
-        const double MAX_RENDER_DIST = 16.0;
-
-        double shotDistance = sqrt(pow(shot.x - player.getX(), 2) + pow(shot.y - player.getY(), 2));
-        double shotRadius = MAX_RADIUS / (shotDistance + 1);
-        double angleDiff = player.getAngle() - shot.angle;
-
-        // Cast a ray from the player to the shot to check if there isn't a obstacle between them.
-        // If it doesn't hit the the shot, the distance will be lower than shotDistance.
-        Ray ray(shot.angle);
-        ray.setMaxDepth(MAX_RENDER_DIST);
-        ray.castRay(player.getX(), player.getY(), MAP_WIDTH, MAP_HEIGHT, map, objective);
-
-        if (ray.getDistance() < shotDistance || fabs(angleDiff) > player.getFOV() / 2) continue;
-
-        // Calculation of the shot position on the screen
-        double radiusFactor = 1 - shotRadius / MAX_RADIUS;                              //< The bigger the radius, the higher the shot should be on the screen.
-        double horizontalPerspectiveFactor = 1 - angleDiff / (player.getFOV() / 2);     //< When shooting in wide angles, the shot should be more to the side.
-
-        double shotScreenY = SCREEN_HEIGHT - radiusFactor * (SCREEN_HEIGHT / 2.0);
-        double shotScreenX = SCREEN_WIDTH - radiusFactor * horizontalPerspectiveFactor * (SCREEN_WIDTH / 2.0) ;
-        
-        #ifdef _DEBUG
-        if (shotScreenX > 0 && shotScreenX < SCREEN_WIDTH && shotScreenY > 0 && shotScreenY < SCREEN_HEIGHT)
-        {
-            screen[int(shotScreenY) * SCREEN_WIDTH] = '>';
-            screen[int(shotScreenX)] = 'v';
-        }
-        #endif
-
-        // Render the shot on the screen
-        for (int x = shotScreenX - shotRadius; x < shotScreenX + shotRadius; x++)
-        {
-            for (int y = shotScreenY - shotRadius; y < shotScreenY + shotRadius; y++)
-            {
-                if (x < 0 || x >= SCREEN_WIDTH || y < 0 || y >= SCREEN_HEIGHT) continue;
-
-                double dx = x - shotScreenX;
-                double dy = (y - shotScreenY) * 2.0; // Multiply by 2 to make the shot more round
-                double distanceFromShot = sqrt(dx * dx + dy * dy);
-
-                if (distanceFromShot <= shotRadius)
-                {
-                    wchar_t tile = L' ';
-                    double brightness = distanceFromShot / shotRadius; // The closer to the center, the brighter the shot
-                    if (brightness < 0.5)       tile = 0x2588;
-                    else if (brightness < 0.75) tile = 0x2593;
-                    else                        tile = 0x2591;
-                    screen[y * SCREEN_WIDTH + x] = tile;
-                }
-            }
-        }
+        addSprite(shot.x, shot.y, SHOT_RADIUS, SHOT_ELEVATION);
     }
+    if (client)
+    {
+        for (const auto& [x, y] : client->getShots())               addSprite(x, y, SHOT_RADIUS, SHOT_ELEVATION);
+        for (const RemotePlayer& remote : client->getRemotePlayers()) addSprite(remote.x, remote.y, PLAYER_RADIUS, PLAYER_ELEVATION);
+    }
+
+    spriteRenderer.render(screen, player.getX(), player.getY(), player.getAngle(), player.getFOV(), quality.getCurrent().fogDistance);
 }
 
 void Game::findPathToObjective()
 {
-    static int previousPlayerX = -1;
-    static int previousPlayerY = -1;
     int playerX = int(player.getX());
     int playerY = int(player.getY());
 
-    if (previousPlayerX != playerX || previousPlayerY != playerY) // Only find path if the player has moved
+    if (previousPathX != playerX || previousPathY != playerY) // Only find path if the player has moved
     {
         int objectiveX = int(objective.getX());
         int objectiveY = int(objective.getY());
 
-        pathToObjective = AStar::findPath(playerX, playerY, objectiveX, objectiveY, MAP_WIDTH, MAP_HEIGHT, map);
+        pathfinder.findPath(playerX, playerY, objectiveX, objectiveY, MAP_WIDTH, MAP_HEIGHT, map, pathToObjective);
     }
 
-    previousPlayerX = int(player.getX());
-    previousPlayerY = int(player.getY());
+    previousPathX = int(player.getX());
+    previousPathY = int(player.getY());
 }
 
-void Game::render2dObjects(wchar_t* screen)
+void Game::render2dObjects(Glyph* screen)
 {
     size_t yOffset = 0;
 
@@ -332,64 +506,68 @@ void Game::render2dObjects(wchar_t* screen)
 
     if (showMap)
     {
-        // Draw the map
-        for (int i = 0; i < MAP_HEIGHT; ++i)
-        {
-            for (int j = 0; j < MAP_WIDTH; ++j)
-            {
-                screen[(i + yOffset) * SCREEN_WIDTH + j] = map[i * MAP_WIDTH + j];
-            }
-        }
+        // Draw the walls, only rebuilt when the map changes
+        minimap.update(map, MAP_WIDTH, MAP_HEIGHT);
+        minimap.scrollTo(int(player.getX()), int(player.getY()));
+        minimap.blit(screen, SCREEN_WIDTH, yOffset);
 
         // Draw the path to the objective
         if (showPathToObjective)
         {
             for (std::pair<int, int>& point : pathToObjective)
             {
-                int pathX = point.first;
-                int pathY = point.second;
-                screen[(pathY + yOffset) * SCREEN_WIDTH + pathX] = '.';
+                minimap.plot(screen, SCREEN_WIDTH, yOffset, point.first, point.second, '.');
             }
         }
 
         // Draw the player's shoots on map.
-        for (Shot& shot : player.getShots())
+        for (const Shot& shot : player.getShots())
         {
-            screen[(int(shot.y) + yOffset) * SCREEN_WIDTH + int(shot.x)] = '*';
+            minimap.plot(screen, SCREEN_WIDTH, yOffset, int(shot.x), int(shot.y), '*');
+        }
+
+        // Draw the shots and the other players of a multiplayer game
+        if (client)
+        {
+            for (const auto& [x, y] : client->getShots())
+            {
+                minimap.plot(screen, SCREEN_WIDTH, yOffset, int(x), int(y), '*');
+            }
+            for (const RemotePlayer& remote : client->getRemotePlayers())
+            {
+                minimap.plot(screen, SCREEN_WIDTH, yOffset, int(remote.x), int(remote.y), remote.tile);
+            }
         }
 
         // Draw the objective and the player
-        screen[int((objective.getY()) + yOffset) * SCREEN_WIDTH + int(objective.getX())] = objective.getTile();
-        screen[(int(player.getY()) + yOffset) * SCREEN_WIDTH + int(player.getX())] = player.getTile();
+        minimap.plot(screen, SCREEN_WIDTH, yOffset, int(objective.getX()), int(objective.getY()), objective.getTile());
+        minimap.plot(screen, SCREEN_WIDTH, yOffset, int(player.getX()), int(player.getY()), player.getTile());
     }
 
     screen[(SCREEN_HEIGHT / 2) * SCREEN_WIDTH + SCREEN_WIDTH / 2] = '+';
 }
 
-void Game::showDebugInfo(wchar_t* screen, size_t& yOffset)
+void Game::showDebugInfo(Glyph* screen, size_t& yOffset)
 {
     #ifdef _DEBUG
-    static auto previous = std::chrono::high_resolution_clock::now();
     auto current = std::chrono::high_resolution_clock::now();
 
-    static double fps = 0.0;
-
-    std::string debug;
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2);
-    oss << "X=" << player.getX() << " Y=" << player.getY() << " Angle=" << player.getAngle();
-    oss << " FOV=" << player.getFOV() << " FPS=" << fps;
-    debug = oss.str();
-    for (std::size_t i = 0; i < debug.size(); ++i)
+    char debug[256];    // Formatted on the stack, the debug line mustn't allocate every frame
+    int length = std::snprintf(debug, sizeof(debug), "X=%.2f Y=%.2f Angle=%.2f FOV=%.2f FPS=%.2f Allocs=%zu LOD=%d Path=%zu nodes/%.2fms Late=%zu",
+                               player.getX(), player.getY(), player.getAngle(), player.getFOV(), fps,
+                               frameAllocations, quality.getLevel(),
+                               pathfinder.getStats().expandedNodes, pathfinder.getStats().milliseconds,
+                               framePacer.getMissedDeadlines());
+    for (int i = 0; i < length && i < SCREEN_WIDTH && i < int(sizeof(debug)); ++i)
     {
         screen[i] = debug[i];
     }
 
-    std::chrono::duration<double> elapsed = current - previous;
+    std::chrono::duration<double> elapsed = current - lastFpsUpdate;
     if (elapsed.count() > 1/6.0)
     {
         fps = 1.0 / deltaTime;
-        previous = current;
+        lastFpsUpdate = current;
     }
 
     yOffset++;
@@ -0,0 +1,102 @@
+/**
+ * @file glyphs.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief The characters the screen can show, implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "glyphs.hpp"
+#include <array>
+#include <cstring>
+
+struct Utf8Glyph
+{
+    char bytes[4];          // Padded, so every glyph is copied as 4 bytes.
+    std::uint8_t length;
+};
+
+static constexpr std::uint32_t codePointOf(Glyph glyph)
+{
+    switch (glyph)
+    {
+        case Glyphs::LIGHT_SHADE:   return 0x2591;
+        case Glyphs::MEDIUM_SHADE:  return 0x2592;
+        case Glyphs::DARK_SHADE:    return 0x2593;
+        case Glyphs::FULL_BLOCK:    return 0x2588;
+        case Glyphs::NOISE:         return 0x25CB;
+        default:                    break;
+    }
+
+    if (glyph >= Glyphs::ETHIOPIC_FIRST && glyph < Glyphs::COUNT) return 0x1200 + (glyph - Glyphs::ETHIOPIC_FIRST);
+    if (glyph < 0x20 || glyph >= 0x7F) return ' ';     // Control characters, the screen's terminator and unused indices
+    return glyph;
+}
+
+static constexpr Utf8Glyph encodeUtf8(std::uint32_t c)
+{
+    Utf8Glyph glyph{};
+    if (c < 0x80)
+    {
+        glyph.bytes[0] = char(c);
+        glyph.length = 1;
+    }
+    else if (c < 0x800)
+    {
+        glyph.bytes[0] = char(0xC0 | (c >> 6));
+        glyph.bytes[1] = char(0x80 | (c & 0x3F));
+        glyph.length = 2;
+    }
+    else
+    {
+        glyph.bytes[0] = char(0xE0 | (c >> 12));
+        glyph.bytes[1] = char(0x80 | ((c >> 6) & 0x3F));
+        glyph.bytes[2] = char(0x80 | (c & 0x3F));
+        glyph.length = 3;
+    }
+    return glyph;
+}
+
+static constexpr auto UTF8_TABLE = []() {
+    std::array<Utf8Glyph, Glyphs::COUNT> table{};
+    for (Glyph glyph = 0; glyph < Glyphs::COUNT; ++glyph) table[glyph] = encodeUtf8(codePointOf(glyph));
+    return table;
+}();
+
+static constexpr auto WIDE_TABLE = []() {
+    std::array<wchar_t, Glyphs::COUNT> table{};
+    for (Glyph glyph = 0; glyph < Glyphs::COUNT; ++glyph) table[glyph] = wchar_t(codePointOf(glyph));
+    return table;
+}();
+
+std::uint32_t Glyphs::toCodePoint(Glyph glyph)
+{
+    return codePointOf(glyph);
+}
+
+void Glyphs::appendUtf8(std::string& out, const Glyph* cells, int count)
+{
+    // Room for 4 bytes per cell, so each glyph is copied whole and the string is trimmed once at the end
+    std::size_t length = out.size();
+    out.resize(length + std::size_t(count) * 4);
+
+    char* data = out.data();
+    for (int i = 0; i < count; ++i)
+    {
+        const Utf8Glyph& glyph = UTF8_TABLE[cells[i] < COUNT ? cells[i] : Glyph(' ')];
+        std::memcpy(data + length, glyph.bytes, 4);
+        length += glyph.length;
+    }
+
+    out.resize(length);
+}
+
+void Glyphs::toWide(wchar_t* out, const Glyph* cells, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        out[i] = WIDE_TABLE[cells[i] < COUNT ? cells[i] : Glyph(' ')];
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file inputThread.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief InputThread class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "inputThread.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+void InputThread::push(const InputEvent& event)
+{
+    while (!events.push(event))
+    {
+        if (stopping) return;
+        std::this_thread::yield();
+    }
+}
+
+#ifdef _WIN32
+
+void InputThread::start()
+{
+    if (thread.joinable()) return;
+
+    stopping = false;
+    thread = std::thread(&InputThread::run, this);
+}
+
+void InputThread::run()
+{
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+    std::array<bool, 256> down{};   // The thread's own key states, to drop the repeats of held keys
+
+    POINT lastMousePos;
+    GetCursorPos(&lastMousePos);
+    const int screenWidth = GetSystemMetrics(SM_CXSCREEN);
+    const int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+
+    while (!stopping)
+    {
+        // Wakes up when a key event arrives, or after 1 ms to sample the mouse
+        if (WaitForSingleObject(input, 1) == WAIT_OBJECT_0)
+        {
+            INPUT_RECORD records[32];
+            DWORD count = 0;
+            ReadConsoleInputW(input, records, 32, &count);
+
+            for (DWORD i = 0; i < count; ++i)
+            {
+                if (records[i].EventType != KEY_EVENT) continue;
+
+                const KEY_EVENT_RECORD& key = records[i].Event.KeyEvent;
+                const int code = key.wVirtualKeyCode & 0xFF;
+                const bool isDown = key.bKeyDown;
+                if (down[code] == isDown) continue;
+
+                down[code] = isDown;
+                push({ isDown ? InputEvent::Type::KEY_DOWN : InputEvent::Type::KEY_UP, code, Clock::now() });
+            }
+        }
+
+        POINT mousePos;
+        GetCursorPos(&mousePos);
+        if (mousePos.x != lastMousePos.x) push({ InputEvent::Type::MOUSE_MOVE, int(mousePos.x - lastMousePos.x), Clock::now() });
+        lastMousePos = mousePos;
+
+        // Keeps the pointer near the center, so it never stops at the edge of the screen
+        if (mousePos.x < screenWidth / 2 - 300 || mousePos.x > screenWidth / 2 + 300)
+        {
+            SetCursorPos(screenWidth / 2, screenHeight / 2);
+            lastMousePos = { screenWidth / 2, screenHeight / 2 };
+        }
+    }
+}
+
+#endif // _WIN32
+
+void InputThread::stop()
+{
+    stopping = true;
+    if (thread.joinable()) thread.join();
+}
+
+InputState InputThread::poll()
+{
+    InputState input;
+    std::array<bool, 256> pressed{};    // The keys that went down since the last poll, even if released already
+
+    const auto now = Clock::now();
+    latency = 0.0;
+
+    InputEvent event;
+    while (events.pop(event))
+    {
+        latency = std::max(latency, std::chrono::duration<double>(now - event.time).count());
+
+        switch (event.type)
+        {
+            case InputEvent::Type::KEY_DOWN:
+                pressed[event.value] = pressed[event.value] || !held[event.value];
+                held[event.value] = true;
+                break;
+            case InputEvent::Type::KEY_UP:
+                held[event.value] = false;
+                break;
+            case InputEvent::Type::MOUSE_MOVE:
+                input.mouseDeltaX += event.value;
+                break;
+        }
+    }
+
+    auto isActive = [&](int key) { return held[key] || pressed[key]; };
+    input.forward = isActive('W');
+    input.backward = isActive('S');
+    input.left = isActive('A');
+    input.right = isActive('D');
+    input.zoom = isActive('Q');
+    input.shoot = isActive(KEY_SPACE);
+    input.quit = isActive(KEY_ESCAPE);
+
+    input.toggleMap = pressed['M'];
+    input.toggleFOV = pressed['E'];
+    input.togglePath = pressed['P'];
+    input.use = pressed['F'];
+
+    return input;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file landmarks.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Landmarks class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "landmarks.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+using namespace AStar;
+
+void Landmarks::computeDistances(const std::string& map, int mapWidth, int mapHeight, int source, std::vector<Cost>& result)
+{
+    using Entry = std::pair<Cost, int>;
+
+    result.assign(map.size(), UNREACHABLE);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    result[source] = 0;
+    open.push({ 0, source });
+
+    while (!open.empty())
+    {
+        auto [distance, cell] = open.top();
+        open.pop();
+        if (distance > result[cell]) continue;
+
+        const int x = cell % mapWidth;
+        const int y = cell / mapWidth;
+        for (int i = 0; i < EightWay::COUNT; ++i)
+        {
+            const int neighbourX = x + EightWay::OFFSETS_X[i];
+            const int neighbourY = y + EightWay::OFFSETS_Y[i];
+            if (neighbourX < 0 || neighbourX >= mapWidth || neighbourY < 0 || neighbourY >= mapHeight) continue;
+
+            const int neighbour = neighbourY * mapWidth + neighbourX;
+            if (map[neighbour] != ' ') continue;
+
+            const Cost neighbourDistance = distance + (i < 4 ? STRAIGHT_COST : DIAGONAL_COST);
+            if (neighbourDistance >= result[neighbour]) continue;
+
+            result[neighbour] = neighbourDistance;
+            open.push({ neighbourDistance, neighbour });
+        }
+    }
+}
+
+void Landmarks::build(const std::string& map, int mapWidth, int mapHeight, int landmarkCount)
+{
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    cells.clear();
+
+    // The walking distance from the free cell nearest to the center of the map
+    const double centerX = (mapWidth - 1) / 2.0;
+    const double centerY = (mapHeight - 1) / 2.0;
+    int center = -1;
+    double centerDistance = std::numeric_limits<double>::infinity();
+    for (int cell = 0; cell < int(map.size()); ++cell)
+    {
+        const double dx = cell % mapWidth - centerX;
+        const double dy = cell / mapWidth - centerY;
+        if (map[cell] == ' ' && dx * dx + dy * dy < centerDistance)
+        {
+            center = cell;
+            centerDistance = dx * dx + dy * dy;
+        }
+    }
+    if (center < 0) return;
+
+    std::vector<Cost> fromCenter;
+    computeDistances(map, mapWidth, mapHeight, center, fromCenter);
+
+    // The map is cut in equal angles around its center, and each slice's landmark is the cell farthest to
+    // walk to from the center, the end of a long corridor: behind most goals, seen from most starts
+    std::vector<Cost> farthestDistance(landmarkCount, 0);
+    std::vector<int> farthest(landmarkCount, -1);
+    for (int cell = 0; cell < int(map.size()); ++cell)
+    {
+        if (fromCenter[cell] == UNREACHABLE) continue;
+
+        const double x = (cell % mapWidth - centerX) / mapWidth;       // Scaled, so the slices are even on wide maps
+        const double y = (cell / mapWidth - centerY) / mapHeight;
+        const double angle = std::atan2(y, x) + 3.14159265358979323846;
+        const int slice = std::min(landmarkCount - 1, int(angle / (2.0 * 3.14159265358979323846) * landmarkCount));
+
+        if (farthest[slice] < 0 || fromCenter[cell] > farthestDistance[slice])
+        {
+            farthestDistance[slice] = fromCenter[cell];
+            farthest[slice] = cell;
+        }
+    }
+
+    for (int cell : farthest)
+    {
+        if (cell >= 0) cells.push_back(cell);
+    }
+    count = int(cells.size());
+
+    std::vector<std::vector<Cost>> fields(count);
+    parallelFor(count, [&](int landmark) {
+        computeDistances(map, mapWidth, mapHeight, cells[landmark], fields[landmark]);
+    });
+
+    // Interleaved by cell
+    distances.resize(map.size() * count);
+    for (std::size_t cell = 0; cell < map.size(); ++cell)
+    {
+        for (int landmark = 0; landmark < count; ++landmark)
+        {
+            distances[cell * count + landmark] = fields[landmark][cell];
+        }
+    }
+}
+
+std::shared_ptr<const Landmarks> Landmarks::share(const std::string& map, int mapWidth, int mapHeight)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const Landmarks>> tables;
+
+    std::string key = std::to_string(mapWidth) + 'x' + std::to_string(mapHeight) + ':' + map;
+
+    // The lock is held while building, so games loading the same map at once wait for one build
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto landmarks = tables[key].lock()) return landmarks;
+
+    for (auto it = tables.begin(); it != tables.end();)     // Forgets the released tables
+    {
+        if (it->second.expired())   it = tables.erase(it);
+        else                        ++it;
+    }
+
+    auto landmarks = std::make_shared<Landmarks>();
+    landmarks->build(map, mapWidth, mapHeight);
+    tables[key] = landmarks;
+    return landmarks;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file lighting.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Lighting class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "lighting.hpp"
+#include "parallel.hpp"
+#include <cmath>
+
+constexpr int STATIC_INTENSITY = 255;       // The light of a lamp in its own cell, fading to 0 at STATIC_RADIUS.
+constexpr int DYNAMIC_INTENSITY = 192;
+
+Lighting::Lighting()
+{
+    // Light moves the floor glyphs of a band towards the dense ones of the nearest band
+    const Glyph ramp[FLOOR_BANDS] = { ' ', '.', 'x', '#' };
+    for (int band = 0; band < FLOOR_BANDS; ++band)
+    {
+        for (int level = 0; level < LEVELS; ++level)
+        {
+            floorGlyphs[band][level] = ramp[std::min(FLOOR_BANDS - 1, FLOOR_BANDS - 1 - band + level)];
+        }
+    }
+
+    hashCells.assign(HASH_SIZE, -1);
+    hashLight.assign(HASH_SIZE, 0);
+}
+
+bool Lighting::hasLineOfSight(double fromX, double fromY, int toCell) const
+{
+    const int toX = toCell % mapWidth;
+    const int toY = toCell / mapWidth;
+    const double dx = toX + 0.5 - fromX;
+    const double dy = toY + 0.5 - fromY;
+
+    // Walks the cells crossed by the line, crossing to the next column or row by whichever comes first
+    int x = int(fromX);
+    int y = int(fromY);
+    const int stepX = dx > 0.0 ? 1 : -1;
+    const int stepY = dy > 0.0 ? 1 : -1;
+    const double deltaX = dx != 0.0 ? std::abs(1.0 / dx) : INFINITY;
+    const double deltaY = dy != 0.0 ? std::abs(1.0 / dy) : INFINITY;
+    double nextX = dx != 0.0 ? (dx > 0.0 ? x + 1 - fromX : fromX - x) * deltaX : INFINITY;
+    double nextY = dy != 0.0 ? (dy > 0.0 ? y + 1 - fromY : fromY - y) * deltaY : INFINITY;
+
+    for (int steps = std::abs(toX - x) + std::abs(toY - y); steps > 0; --steps)
+    {
+        if ((*map)[y * mapWidth + x] == '#') return false;
+
+        if (nextX < nextY)
+        {
+            nextX += deltaX;
+            x += stepX;
+        }
+        else
+        {
+            nextY += deltaY;
+            y += stepY;
+        }
+    }
+
+    return true;
+}
+
+std::uint8_t Lighting::bakeCell(int cell) const
+{
+    const int x = cell % mapWidth;
+    const int y = cell / mapWidth;
+
+    int light = 0;
+    for (int lamp : lamps)
+    {
+        const double dx = lamp % mapWidth - x;
+        const double dy = lamp / mapWidth - y;
+        const double distance = std::sqrt(dx * dx + dy * dy);
+        if (distance >= STATIC_RADIUS || !hasLineOfSight(lamp % mapWidth + 0.5, lamp / mapWidth + 0.5, cell)) continue;
+
+        light += int(STATIC_INTENSITY * (1.0 - distance / STATIC_RADIUS));
+    }
+
+    return std::uint8_t(std::min(light, 255));
+}
+
+int Lighting::findSlot(int cell) const
+{
+    int slot = int((std::uint32_t(cell) * 2654435761u) >> (32 - HASH_BITS));
+    while (hashCells[slot] != -1 && hashCells[slot] != cell) slot = (slot + 1) & (HASH_SIZE - 1);
+    return slot;
+}
+
+void Lighting::refreshLevel(int cell)
+{
+    int light = staticLight[cell];
+    const int slot = findSlot(cell);
+    if (hashCells[slot] == cell) light += hashLight[slot];
+
+    const std::uint8_t level = std::uint8_t(std::min(LEVELS - 1, light * LEVELS / 256));
+    if (levels[cell] == level) return;
+
+    levels[cell] = level;
+    version++;
+}
+
+void Lighting::load(std::string& map, int mapWidth, int mapHeight)
+{
+    this->map = &map;
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    lamps.clear();
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (map[i] != 'o') continue;
+
+        lamps.push_back(i);
+        map[i] = ' ';
+    }
+
+    staticLight.assign(map.size(), 0);
+    levels.assign(map.size(), 0);
+    parallelFor(mapHeight, [&](int y) {
+        for (int x = 0; x < mapWidth; ++x)
+        {
+            const int cell = y * mapWidth + x;
+            staticLight[cell] = bakeCell(cell);
+            levels[cell] = std::uint8_t(std::min(LEVELS - 1, staticLight[cell] * LEVELS / 256));
+        }
+    });
+    version++;
+}
+
+void Lighting::updateAround(int cell)
+{
+    if (lamps.empty()) return;
+
+    // A line of sight through the cell joins a lamp and a cell both within STATIC_RADIUS of it
+    const int cellX = cell % mapWidth;
+    const int cellY = cell / mapWidth;
+    for (int y = std::max(0, cellY - 2 * STATIC_RADIUS); y <= std::min(mapHeight - 1, cellY + 2 * STATIC_RADIUS); ++y)
+    {
+        for (int x = std::max(0, cellX - 2 * STATIC_RADIUS); x <= std::min(mapWidth - 1, cellX + 2 * STATIC_RADIUS); ++x)
+        {
+            staticLight[y * mapWidth + x] = bakeCell(y * mapWidth + x);
+            refreshLevel(y * mapWidth + x);
+        }
+    }
+}
+
+void Lighting::clearDynamicLights()
+{
+    for (int slot : litSlots) hashLight[slot] = 0;
+    for (int slot : litSlots) refreshLevel(hashCells[slot]);
+
+    // Emptied after the levels are refreshed, since the probes cross the other slots
+    for (int slot : litSlots) hashCells[slot] = -1;
+    litSlots.clear();
+    dynamicLights = 0;
+}
+
+void Lighting::addDynamicLight(double x, double y)
+{
+    if (dynamicLights == MAX_DYNAMIC_LIGHTS || x < 0.0 || x >= mapWidth || y < 0.0 || y >= mapHeight) return;
+    dynamicLights++;
+
+    const int lightX = int(x);
+    const int lightY = int(y);
+    for (int cellY = std::max(0, lightY - DYNAMIC_RADIUS); cellY <= std::min(mapHeight - 1, lightY + DYNAMIC_RADIUS); ++cellY)
+    {
+        for (int cellX = std::max(0, lightX - DYNAMIC_RADIUS); cellX <= std::min(mapWidth - 1, lightX + DYNAMIC_RADIUS); ++cellX)
+        {
+            const double dx = cellX + 0.5 - x;
+            const double dy = cellY + 0.5 - y;
+            const double distance = std::sqrt(dx * dx + dy * dy);
+            const int cell = cellY * mapWidth + cellX;
+            if (distance >= DYNAMIC_RADIUS || !hasLineOfSight(x, y, cell)) continue;
+
+            const int slot = findSlot(cell);
+            if (hashCells[slot] == -1)
+            {
+                hashCells[slot] = cell;
+                litSlots.push_back(slot);
+            }
+            hashLight[slot] = std::uint16_t(hashLight[slot] + int(DYNAMIC_INTENSITY * (1.0 - distance / DYNAMIC_RADIUS)));
+            refreshLevel(cell);
+        }
+    }
+}
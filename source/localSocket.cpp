@@ -0,0 +1,148 @@
+/**
+ * @file localSocket.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Local socket wrapper implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "localSocket.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#include <cstdio>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+static bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+
+static void setNonBlocking(SOCKET socket)
+{
+    u_long mode = 1;
+    ioctlsocket(socket, FIONBIO, &mode);
+}
+
+static void removeFile(const std::string& path) { std::remove(path.c_str()); }
+
+static SOCKET toNative(LocalSocket::Handle socket) { return SOCKET(socket); }
+
+#else
+
+static bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+
+static void setNonBlocking(int socket) { fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK); }
+
+static void removeFile(const std::string& path) { unlink(path.c_str()); }
+
+static int toNative(LocalSocket::Handle socket) { return int(socket); }
+
+#endif // _WIN32
+
+static bool makeAddress(const std::string& path, sockaddr_un& address)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) return false;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool LocalSocket::initialize()
+{
+    #ifdef _WIN32
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    #else
+    return true;
+    #endif
+}
+
+LocalSocket::Handle LocalSocket::listen(const std::string& path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address)) return INVALID;
+
+    auto listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Handle(listener) == INVALID) return INVALID;
+
+    removeFile(path);
+    if (::bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || ::listen(listener, 64) != 0)
+    {
+        close(Handle(listener));
+        return INVALID;
+    }
+
+    setNonBlocking(listener);
+    return Handle(listener);
+}
+
+LocalSocket::Handle LocalSocket::accept(Handle listener)
+{
+    auto client = ::accept(toNative(listener), nullptr, nullptr);
+    if (Handle(client) == INVALID) return INVALID;
+
+    setNonBlocking(client);
+    return Handle(client);
+}
+
+LocalSocket::Handle LocalSocket::connect(const std::string& path)
+{
+    sockaddr_un address;
+    if (!makeAddress(path, address)) return INVALID;
+
+    auto socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (Handle(socket) == INVALID) return INVALID;
+
+    if (::connect(socket, (sockaddr*)&address, sizeof(address)) != 0)
+    {
+        close(Handle(socket));
+        return INVALID;
+    }
+
+    setNonBlocking(socket);
+    return Handle(socket);
+}
+
+int LocalSocket::receive(Handle socket, void* buffer, int size)
+{
+    int received = int(::recv(toNative(socket), (char*)buffer, size, 0));
+
+    if (received > 0)                   return received;
+    if (received < 0 && wouldBlock())   return 0;
+    return -1;  // Closed by the peer or failed
+}
+
+int LocalSocket::send(Handle socket, const void* data, int size)
+{
+    #ifdef _WIN32
+    int sent = ::send(toNative(socket), (const char*)data, size, 0);
+    #else
+    int sent = int(::send(toNative(socket), data, size, MSG_NOSIGNAL));  // Don't die with SIGPIPE if the client left
+    #endif
+
+    if (sent >= 0)      return sent;
+    if (wouldBlock())   return 0;
+    return -1;
+}
+
+void LocalSocket::close(Handle socket)
+{
+    if (socket == INVALID) return;
+
+    #ifdef _WIN32
+    ::closesocket(toNative(socket));
+    #else
+    ::close(toNative(socket));
+    #endif
+}
@@ -9,13 +9,150 @@
  */
 
 #include <iostream>
+#include <string>
 #include "game.hpp"
+#include "server.hpp"
+#include "multiplayerServer.hpp"
+#include "multiplayerClient.hpp"
+#include "batchPathfinder.hpp"
+#include <thread>
 
-int main()
+int main(int argc, char* argv[])
 {
-    Game game;
+    std::string tracePath;
+    int minimapScale = 1;
+    double targetFps = -1.0;                // Negative keeps the default
+    double fogDistance = -1.0;
+    double maxFps = -1.0;
+    double idleFps = -1.0;
+    SessionServer::Config server;
+    bool serverMode = false;
+    MultiplayerServer::Config multiplayer;
+    bool multiplayerServer = false;
+    bool multiplayerClient = false;
+    int botCount = 0;
+    int mazeWidth = 0;                      // 0 keeps the default map
+    int mazeHeight = 0;
+    std::uint32_t seed = 1;
+    int pathBenchmarkQueries = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--trace" && i + 1 < argc)              tracePath = argv[++i];                       // Usage: --trace frames.json
+        else if (arg == "--minimap-scale" && i + 1 < argc) minimapScale = std::stoi(argv[++i]);         // Usage: --minimap-scale 2
+        else if (arg == "--target-fps" && i + 1 < argc)    targetFps = std::stod(argv[++i]);            // Usage: --target-fps 60
+        else if (arg == "--fog" && i + 1 < argc)           fogDistance = std::stod(argv[++i]);          // Usage: --fog 10
+        else if (arg == "--max-fps" && i + 1 < argc)       maxFps = std::stod(argv[++i]);               // Usage: --max-fps 144
+        else if (arg == "--idle-fps" && i + 1 < argc)      idleFps = std::stod(argv[++i]);              // Usage: --idle-fps 10
+        else if (arg == "--server" && i + 1 < argc)                                                     // Usage: --server 200
+        {
+            serverMode = true;
+            server.sessionCount = std::stoi(argv[++i]);
+        }
+        else if (arg == "--socket" && i + 1 < argc)        server.socketPath = argv[++i];               // Usage: --socket game.sock
+        else if (arg == "--tick-rate" && i + 1 < argc)                                                  // Usage: --tick-rate 30
+        {
+            server.tickRate = std::stod(argv[++i]);
+            multiplayer.tickRate = server.tickRate;
+        }
+        else if (arg == "--threads" && i + 1 < argc)       server.threadCount = std::stoi(argv[++i]);   // Usage: --threads 8
+        else if (arg == "--duration" && i + 1 < argc)                                                   // Usage: --duration 60
+        {
+            server.duration = std::stod(argv[++i]);
+            multiplayer.duration = server.duration;
+        }
+        else if (arg == "--mp-server" && i + 1 < argc)                                                  // Usage: --mp-server 8
+        {
+            multiplayerServer = true;
+            multiplayer.maxPlayers = std::stoi(argv[++i]);
+        }
+        else if (arg == "--mp-client")                     multiplayerClient = true;                    // Usage: --mp-client
+        else if (arg == "--mp-bots" && i + 1 < argc)       botCount = std::stoi(argv[++i]);             // Usage: --mp-bots 4
+        else if (arg == "--mp-socket" && i + 1 < argc)     multiplayer.socketPath = argv[++i];          // Usage: --mp-socket mp.sock
+        else if (arg == "--maze" && i + 1 < argc)                                                       // Usage: --maze 200x100
+        {
+            std::string size = argv[++i];
+            std::size_t separator = size.find('x');
+            if (separator == std::string::npos) continue;
+            mazeWidth = std::stoi(size.substr(0, separator));
+            mazeHeight = std::stoi(size.substr(separator + 1));
+        }
+        else if (arg == "--path-bench" && i + 1 < argc)    pathBenchmarkQueries = std::stoi(argv[++i]); // Usage: --path-bench 10000
+        else if (arg == "--seed" && i + 1 < argc)          seed = std::uint32_t(std::stoul(argv[++i])); // Usage: --seed 42
+    }
+
+    MapData map = mazeWidth > 0 && mazeHeight > 0 ? Maps::generateMaze(mazeWidth, mazeHeight, seed) : Maps::defaultMap();
+    server.map = map;
+    server.seed = seed;
+    multiplayer.map = map;
+    multiplayer.seed = seed;
+
+    auto configureGame = [&](Game& game) {
+        if (targetFps >= 0.0)    game.setTargetFps(targetFps);
+        if (fogDistance >= 0.0)  game.setFogDistance(fogDistance);
+        if (maxFps >= 0.0)       game.setMaxFps(maxFps);
+        if (idleFps >= 0.0)      game.setIdleFps(idleFps);
+        game.setMinimapScale(minimapScale);
+    };
+
+    if (pathBenchmarkQueries > 0)
+    {
+        BatchPathfinder::runBenchmark(map, pathBenchmarkQueries, server.threadCount, seed);
+        return 0;
+    }
+
+    if (multiplayerServer)
+    {
+        // Bots in the same process test the server over loopback
+        std::thread bots;
+        double botDuration = multiplayer.duration > 0.0 ? multiplayer.duration * 0.75 : 60.0;  // Done before the server
+        if (botCount > 0) bots = std::thread([&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            MultiplayerClient::runBots(multiplayer.socketPath, botCount, botDuration);
+        });
+
+        bool ok = MultiplayerServer(multiplayer).run();
+        if (bots.joinable()) bots.join();
+        return ok ? 0 : 1;
+    }
+    if (botCount > 0)
+    {
+        MultiplayerClient::runBots(multiplayer.socketPath, botCount, server.duration > 0.0 ? server.duration : 60.0);
+        return 0;
+    }
+
+    if (serverMode)
+    {
+        server.configureGame = configureGame;
+        SessionServer sessionServer(server);
+        return sessionServer.run() ? 0 : 1;
+    }
+
+    #ifdef _WIN32
+    // A client plays on the server's map, so it connects before the game is built
+    MultiplayerClient client;
+    if (multiplayerClient)
+    {
+        if (!client.connect(multiplayer.socketPath))
+        {
+            std::cerr << "Couldn't join the game at " << multiplayer.socketPath << std::endl;
+            return 1;
+        }
+        map = MapData{ client.getMap(), client.getMapWidth(), client.getMapHeight() };
+    }
+
+    Game game(std::move(map));
+    configureGame(game);
+    if (!tracePath.empty()) game.enableTracing(tracePath);
+    if (multiplayerClient) game.attachClient(&client);
 
     game.run();
+    #else
+    if (multiplayerClient)  std::cerr << "The multiplayer client needs the Windows console, use --mp-bots to test a server." << std::endl;
+    else                    std::cerr << "Only the server modes (--server, --mp-server and --mp-bots) are available on this platform." << std::endl;
+    return 1;
+    #endif
 
     return 0;
 }
@@ -0,0 +1,103 @@
+/**
+ * @file mapEditor.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MapEditor class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "mapEditor.hpp"
+#include <algorithm>
+
+void MapEditor::load(std::string& map, int mapWidth, int mapHeight)
+{
+    this->map = &map;
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    kinds.assign(map.size(), CellKind::FIXED);
+    doors.clear();
+    version = 0;
+
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (map[i] == 'D')
+        {
+            kinds[i] = CellKind::DOOR;
+            doors.push_back(i);
+            map[i] = '#';
+        }
+        else if (map[i] == '%')
+        {
+            kinds[i] = CellKind::DESTRUCTIBLE;
+            map[i] = '#';
+        }
+    }
+}
+
+std::string MapEditor::getOpenMap() const
+{
+    std::string openMap = *map;
+    for (std::size_t i = 0; i < openMap.size(); ++i)
+    {
+        if (kinds[i] != CellKind::FIXED) openMap[i] = ' ';
+    }
+
+    return openMap;
+}
+
+bool MapEditor::setTile(int cell, char tile)
+{
+    const char oldTile = (*map)[cell];
+    if (oldTile == tile) return false;
+
+    (*map)[cell] = tile;
+    version++;
+    for (const Listener& listener : listeners) listener(cell, oldTile, tile);
+    return true;
+}
+
+int MapEditor::toggleDoorsAround(double x, double y)
+{
+    const int cellX = int(x);
+    const int cellY = int(y);
+    if (cellX < 0 || cellX >= mapWidth || cellY < 0 || cellY >= mapHeight) return 0;
+
+    // The door cells touching the position, then the cells of the same doors, so a door opens as a whole
+    std::vector<int> door;
+    auto addAround = [&](int cell) {
+        for (int dy = -1; dy <= 1; ++dy)
+        {
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                const int doorX = cell % mapWidth + dx;
+                const int doorY = cell / mapWidth + dy;
+                if (doorX < 0 || doorX >= mapWidth || doorY < 0 || doorY >= mapHeight) continue;
+
+                const int doorCell = doorY * mapWidth + doorX;
+                if (kinds[doorCell] == CellKind::DOOR && std::find(door.begin(), door.end(), doorCell) == door.end()) door.push_back(doorCell);
+            }
+        }
+    };
+
+    const int position = cellY * mapWidth + cellX;
+    addAround(position);
+    for (std::size_t i = 0; i < door.size(); ++i) addAround(door[i]);
+    if (door.empty()) return 0;
+
+    // All the cells follow the first one, and a door doesn't close on whoever stands in it
+    const char tile = (*map)[door.front()] == '#' ? ' ' : '#';
+    if (tile == '#' && std::find(door.begin(), door.end(), position) != door.end()) return 0;
+
+    int toggled = 0;
+    for (int cell : door) toggled += setTile(cell, tile);
+    return toggled;
+}
+
+bool MapEditor::destroy(int cell)
+{
+    if (kinds[cell] != CellKind::DESTRUCTIBLE) return false;
+
+    return setTile(cell, ' ');
+}
@@ -0,0 +1,186 @@
+/**
+ * @file maps.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Game maps implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "maps.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <random>
+
+constexpr int TILE_ROOMS = 32;          // Rooms along each side of a maze tile.
+constexpr std::uint8_t EAST = 1 << 0;   // Passage to the room at the right.
+constexpr std::uint8_t SOUTH = 1 << 1;  // Passage to the room below.
+
+/**
+ * Seeds the generator of a tile from the maze's seed. Source: https://prng.di.unimi.it/splitmix64.c
+ */
+static std::uint32_t tileSeed(std::uint32_t seed, int tile)
+{
+    std::uint64_t hash = (std::uint64_t(seed) << 32 | std::uint32_t(tile)) + 0x9E3779B97F4A7C15;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+    return std::uint32_t(hash ^ (hash >> 31));
+}
+
+/**
+ * Carves a random spanning tree of the rooms in [x0, x1) x [y0, y1) with a randomized depth-first search.
+ * Only the passages between rooms of the rectangle are written.
+ */
+static void carveSpanningTree(std::vector<std::uint8_t>& passages, int roomsX, int x0, int y0, int x1, int y1, std::mt19937& generator)
+{
+    const int width = x1 - x0;
+    const int height = y1 - y0;
+    std::vector<bool> visited(width * height, false);
+    std::vector<int> stack;
+    stack.reserve(width * height);
+
+    int first = int(generator() % (width * height));
+    visited[first] = true;
+    stack.push_back(first);
+
+    while (!stack.empty())
+    {
+        const int current = stack.back();
+        const int x = current % width;
+        const int y = current / width;
+
+        int neighbours[4];
+        int count = 0;
+        if (x > 0 && !visited[current - 1])             neighbours[count++] = current - 1;
+        if (x < width - 1 && !visited[current + 1])     neighbours[count++] = current + 1;
+        if (y > 0 && !visited[current - width])         neighbours[count++] = current - width;
+        if (y < height - 1 && !visited[current + width]) neighbours[count++] = current + width;
+
+        if (count == 0)
+        {
+            stack.pop_back();
+            continue;
+        }
+
+        const int next = neighbours[generator() % count];
+        const int from = std::min(current, next);  // The passage is stored in the room at the left or above
+        const int room = (y0 + from / width) * roomsX + x0 + from % width;
+        passages[room] |= next / width == y ? EAST : SOUTH;   // By row: in a column 1 room wide, the room below is 1 apart too
+
+        visited[next] = true;
+        stack.push_back(next);
+    }
+}
+
+MapData Maps::defaultMap()
+{
+    MapData data;
+    data.width = 66;
+    data.height = 27;
+
+    data.tiles += "##################################################################";
+    data.tiles += "#                             #                                  #";
+    data.tiles += "#    #    #    ##########     #     #########################    #";
+    data.tiles += "#    #    #    #      o       #              o              #    #";
+    data.tiles += "#    #    #####################    #####################    #    #";
+    data.tiles += "#    #                             #                   #    #    #";
+    data.tiles += "#    ###################################     ###########    #    #";
+    data.tiles += "#    #              #                        #         #    #    #";
+    data.tiles += "#    ##########     #    #    ###########    #    #    #    ######";
+    data.tiles += "#    #              #    #    #         #    #    #    #         #";
+    data.tiles += "#    #     ##########    #    #####     #    #    #    #    #    #";
+    data.tiles += "#    #          o        #    #         #    #    #    #    #    #";
+    data.tiles += "#    #####%%%%%###########    #     #####    #    #    #    #    #";
+    data.tiles += "#                             #              #    #    #    #    #";
+    data.tiles += "##########################DDDD################    #    ######    #";
+    data.tiles += "#              #         #    #  X                #    #    o    #";
+    data.tiles += "#    #    #    #    #    #    #    ################    #####     #";
+    data.tiles += "#    #    #    #    #    #    #    #              #              #";
+    data.tiles += "#    #    #    #    #    #    #    #     ####################    #";
+    data.tiles += "#    #    #         #    #    #    #                        #    #";
+    data.tiles += "#    #    ################    #    #    ###########    #    #    #";
+    data.tiles += "#    #          o             #    #    #         #    #    #    #";
+    data.tiles += "#    ##########################    #    #    #    #    #    #    #";
+    data.tiles += "#    #         #              #    #    #    #    #    #    #    #";
+    data.tiles += "#    #    #    ##########     #    #    ######    #    ######    #";
+    data.tiles += "#         #                   #  ^ #              #              #";
+    data.tiles += "##################################################################";
+
+    return data;
+}
+
+MapData Maps::generateMaze(int width, int height, std::uint32_t seed, int corridorWidth)
+{
+    corridorWidth = std::max(1, corridorWidth);
+    const int pitch = corridorWidth + 1;                // A room and the wall at its right or below
+    const int roomsX = std::max(1, (width - 1) / pitch);
+    const int roomsY = std::max(1, (height - 1) / pitch);
+    const int tilesX = (roomsX + TILE_ROOMS - 1) / TILE_ROOMS;
+    const int tilesY = (roomsY + TILE_ROOMS - 1) / TILE_ROOMS;
+
+    std::vector<std::uint8_t> passages(roomsX * roomsY, 0);
+
+    // Each tile is a maze of its own, with a generator of its own
+    parallelFor(tilesX * tilesY, [&](int tile) {
+        const int x0 = tile % tilesX * TILE_ROOMS;
+        const int y0 = tile / tilesX * TILE_ROOMS;
+        std::mt19937 generator(tileSeed(seed, tile));
+        carveSpanningTree(passages, roomsX, x0, y0, std::min(x0 + TILE_ROOMS, roomsX), std::min(y0 + TILE_ROOMS, roomsY), generator);
+    });
+
+    // The tiles are joined along a spanning tree of the tiles, through one random room of each border
+    std::mt19937 generator(seed);
+    std::vector<std::uint8_t> tilePassages(tilesX * tilesY, 0);
+    carveSpanningTree(tilePassages, tilesX, 0, 0, tilesX, tilesY, generator);
+    for (int tile = 0; tile < tilesX * tilesY; ++tile)
+    {
+        const int x0 = tile % tilesX * TILE_ROOMS;
+        const int y0 = tile / tilesX * TILE_ROOMS;
+        const int x1 = std::min(x0 + TILE_ROOMS, roomsX);
+        const int y1 = std::min(y0 + TILE_ROOMS, roomsY);
+
+        if (tilePassages[tile] & EAST)  passages[(y0 + int(generator() % (y1 - y0))) * roomsX + x1 - 1] |= EAST;
+        if (tilePassages[tile] & SOUTH) passages[(y1 - 1) * roomsX + x0 + int(generator() % (x1 - x0))] |= SOUTH;
+    }
+
+    MapData data;
+    data.width = roomsX * pitch + 1;
+    data.height = roomsY * pitch + 1;
+    data.tiles.assign(std::size_t(data.width) * data.height, '#');
+
+    // Each row of rooms writes its rooms and the walls at their right and below, which no other row touches
+    parallelFor(roomsY, [&](int roomY) {
+        const int top = roomY * pitch + 1;
+        for (int roomX = 0; roomX < roomsX; ++roomX)
+        {
+            const int left = roomX * pitch + 1;
+            const std::uint8_t open = passages[roomY * roomsX + roomX];
+
+            for (int y = top; y < top + corridorWidth; ++y)
+            {
+                char* row = &data.tiles[std::size_t(y) * data.width];
+                std::fill(row + left, row + left + corridorWidth, ' ');
+                if (open & EAST) row[left + corridorWidth] = ' ';
+            }
+            if (open & SOUTH)
+            {
+                char* row = &data.tiles[std::size_t(top + corridorWidth) * data.width];
+                std::fill(row + left, row + left + corridorWidth, ' ');
+            }
+        }
+    });
+
+    // The player and the objective start in the middle of different rooms (in a corner of the only room)
+    const int rooms = roomsX * roomsY;
+    const int spawnRoom = int(generator() % rooms);
+    const int objectiveRoom = rooms > 1 ? (spawnRoom + 1 + int(generator() % (rooms - 1))) % rooms : spawnRoom;
+    auto roomCell = [&](int room, int offset) {
+        return std::size_t(room / roomsX * pitch + 1 + offset) * data.width + room % roomsX * pitch + 1 + offset;
+    };
+    data.tiles[roomCell(spawnRoom, corridorWidth / 2)] = '^';
+    if (rooms > 1)                  data.tiles[roomCell(objectiveRoom, corridorWidth / 2)] = 'X';
+    else if (corridorWidth > 1)     data.tiles[roomCell(objectiveRoom, 0)] = 'X';
+
+    return data;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file minimap.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Minimap class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "minimap.hpp"
+#include <algorithm>
+#include <cstring>
+
+void Minimap::update(const std::string& map, int mapWidth, int mapHeight)
+{
+    if (!dirty) return;
+
+    backgroundWidth = (mapWidth + scale - 1) / scale;
+    backgroundHeight = (mapHeight + scale - 1) / scale;
+    background.assign(backgroundWidth * backgroundHeight, ' ');
+
+    for (int y = 0; y < mapHeight; ++y)
+    {
+        for (int x = 0; x < mapWidth; ++x)
+        {
+            // A downsampled cell shows a wall if any of its map cells is a wall
+            char mapTile = map[y * mapWidth + x];
+            Glyph& tile = background[(y / scale) * backgroundWidth + x / scale];
+            if (scale == 1 || mapTile != ' ') tile = mapTile;
+        }
+    }
+
+    dirty = false;
+}
+
+void Minimap::updateCell(const std::string& map, int mapWidth, int mapHeight, int cell)
+{
+    if (dirty) return;  // Rebuilt by the next update() anyway
+
+    // The whole block of map cells of the minimap cell, like update() draws it
+    const int blockX = cell % mapWidth / scale;
+    const int blockY = cell / mapWidth / scale;
+    Glyph& tile = background[blockY * backgroundWidth + blockX];
+    tile = ' ';
+
+    for (int y = blockY * scale; y < std::min(mapHeight, (blockY + 1) * scale); ++y)
+    {
+        for (int x = blockX * scale; x < std::min(mapWidth, (blockX + 1) * scale); ++x)
+        {
+            char mapTile = map[y * mapWidth + x];
+            if (scale == 1 || mapTile != ' ') tile = mapTile;
+        }
+    }
+}
+
+void Minimap::scrollTo(int mapX, int mapY)
+{
+    viewX = std::clamp(mapX / scale - getViewWidth() / 2, 0, backgroundWidth - getViewWidth());
+    viewY = std::clamp(mapY / scale - getViewHeight() / 2, 0, backgroundHeight - getViewHeight());
+}
+
+void Minimap::blit(Glyph* screen, int screenWidth, int yOffset) const
+{
+    const int viewWidth = getViewWidth();
+    const int viewHeight = getViewHeight();
+
+    for (int row = 0; row < viewHeight; ++row)
+    {
+        std::memcpy(screen + (row + yOffset) * screenWidth,
+                    background.data() + (viewY + row) * backgroundWidth + viewX,
+                    viewWidth * sizeof(Glyph));
+    }
+}
+
+void Minimap::plot(Glyph* screen, int screenWidth, int yOffset, int mapX, int mapY, Glyph tile) const
+{
+    int x = mapX / scale - viewX;
+    int y = mapY / scale - viewY;
+
+    if (x < 0 || x >= getViewWidth() || y < 0 || y >= getViewHeight()) return;
+
+    screen[(y + yOffset) * screenWidth + x] = tile;
+}
@@ -0,0 +1,294 @@
+/**
+ * @file multiplayerClient.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MultiplayerClient class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "multiplayerClient.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+bool MultiplayerClient::connect(const std::string& path, double timeout)
+{
+    if (!LocalSocket::initialize()) return false;
+
+    socket = LocalSocket::connect(path);
+    if (socket == LocalSocket::INVALID) return false;
+
+    auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout));
+    while (playerId < 0 || int(map.size()) < mapWidth * mapHeight)
+    {
+        if (!receive() || Clock::now() > deadline)
+        {
+            LocalSocket::close(socket);
+            socket = LocalSocket::INVALID;
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+void MultiplayerClient::update(const InputState& input, double frameTime)
+{
+    if (!isConnected()) return;
+
+    if (!receive())
+    {
+        LocalSocket::close(socket);
+        socket = LocalSocket::INVALID;
+        return;
+    }
+
+    const int turn = input.mouseDeltaX < 0 ? -1 : input.mouseDeltaX > 0 ? 1 : 0;
+    const int openTurn = openInput.mouseDeltaX < 0 ? -1 : openInput.mouseDeltaX > 0 ? 1 : 0;
+    bool inputChanged = input.forward != openInput.forward || input.backward != openInput.backward ||
+                        input.left != openInput.left || input.right != openInput.right ||
+                        input.shoot != openInput.shoot || turn != openTurn;
+    if (openTime > 0.0 && inputChanged) sendOpenCommand();
+
+    openInput = input;
+    openTime += frameTime;
+    if (openTime >= COMMAND_INTERVAL) sendOpenCommand();
+
+    // The command being merged isn't sent yet, but is shown already
+    displayed = predicted;
+    if (openTime > 0.0) Net::simulate(displayed, Net::makeCommand(openInput, openTime, 0), map, mapWidth, mapHeight);
+
+    flush();
+    updateView();
+}
+
+bool MultiplayerClient::receive()
+{
+    char buffer[4096];
+    int received;
+    while ((received = LocalSocket::receive(socket, buffer, int(sizeof(buffer)))) > 0)
+    {
+        incoming.append(buffer, received);
+        bytesReceived += received;
+    }
+
+    Net::MessageType type;
+    std::string_view payload;
+    while (incoming.next(type, payload))
+    {
+        if (type == Net::MessageType::WELCOME && !readWelcome(payload))    return false;
+        if (type == Net::MessageType::MAP)                                  readMap(payload);
+        if (type == Net::MessageType::SNAPSHOT)                             readSnapshot(payload);
+    }
+
+    return received == 0 && !incoming.isMalformed();
+}
+
+bool MultiplayerClient::readWelcome(std::string_view payload)
+{
+    Net::Reader reader(payload);
+    int slot = reader.u8();
+    tickRate = reader.u16() / 100.0;
+    mapWidth = int(reader.u32());
+    mapHeight = int(reader.u32());
+    if (!reader.ok() || tickRate <= 0.0 || mapWidth <= 0 || mapHeight <= 0) return false;
+
+    map.clear();
+    map.reserve(std::size_t(mapWidth) * mapHeight);
+    playerId = slot;
+    return true;
+}
+
+void MultiplayerClient::readMap(std::string_view payload)
+{
+    const std::size_t size = std::size_t(mapWidth) * mapHeight;
+
+    Net::Reader reader(payload);
+    while (reader.ok() && map.size() < size)
+    {
+        std::uint32_t run = reader.varint();
+        char tile = char(reader.u8());
+        if (reader.ok()) map.append(std::min<std::size_t>(run, size - map.size()), tile);
+    }
+}
+
+void MultiplayerClient::readSnapshot(std::string_view payload)
+{
+    Net::Reader reader(payload);
+    std::uint32_t lastSequence = reader.u32();
+    std::uint32_t tick = reader.u32();
+    std::uint32_t baselineTick = reader.u32();
+    if (!reader.ok() || tick <= latestTick) return;
+
+    static const Net::WorldState emptyWorld;
+    const Net::WorldState& baseline = history[baselineTick % Net::HISTORY_SIZE];
+    if (baselineTick != 0 && baseline.tick != baselineTick) return;    // Lost, the server will send a newer delta
+    if (!Net::decodeDelta(baselineTick != 0 ? baseline : emptyWorld, tick, reader, decoded)) return;
+
+    std::swap(history[tick % Net::HISTORY_SIZE], decoded);
+    latestTick = tick;
+    latestTime = Clock::now();
+    snapshotCount++;
+
+    // Reconciliation: the server's state, plus the commands it hasn't applied yet
+    const Net::PlayerState& state = history[tick % Net::HISTORY_SIZE].players[playerId];
+    if (!state.active) return;
+
+    while (!pending.empty() && pending.front().sequence <= lastSequence)
+    {
+        pending.pop_front();
+    }
+
+    double predictedX = predicted.getX();
+    double predictedY = predicted.getY();
+
+    predicted.setX(Net::dequantizePosition(state.x));
+    predicted.setY(Net::dequantizePosition(state.y));
+    predicted.setAngle(Net::dequantizeAngle(state.angle));
+    predicted.updateTile();
+    for (const Net::Command& command : pending)
+    {
+        Net::simulate(predicted, command, map, mapWidth, mapHeight);
+    }
+
+    double error = std::hypot(predicted.getX() - predictedX, predicted.getY() - predictedY);
+    if (error > 1e-9 && snapshotCount > 1)
+    {
+        correctionCount++;
+        correctionDistance += error;
+    }
+}
+
+void MultiplayerClient::sendOpenCommand()
+{
+    // A frame longer than the server accepts is sent as several commands
+    const double maxTime = Net::MAX_COMMAND_MILLISECONDS / 1000.0;
+    while (openTime > 0.0)
+    {
+        const double time = std::min(openTime, maxTime);
+        Net::Command command = Net::makeCommand(openInput, time + timeDebt, nextSequence++);
+        timeDebt += time - command.milliseconds / 1000.0;
+        openTime = openTime > maxTime ? openTime - maxTime : 0.0;
+
+        Net::simulate(predicted, command, map, mapWidth, mapHeight);
+        pending.push_back(command);
+
+        std::size_t start = Net::beginMessage(outgoing, Net::MessageType::COMMAND);
+        Net::Writer writer(outgoing);
+        writer.u32(latestTick);
+        writer.u32(command.sequence);
+        writer.u8(command.buttons);
+        writer.u8(std::uint8_t(command.turn));
+        writer.u8(command.milliseconds);
+        Net::endMessage(outgoing, start);
+    }
+}
+
+void MultiplayerClient::flush()
+{
+    while (outgoingOffset < outgoing.size())
+    {
+        int sent = LocalSocket::send(socket, outgoing.data() + outgoingOffset, int(outgoing.size() - outgoingOffset));
+        if (sent <= 0) break;   // Full or closed, receive() notices the latter
+
+        outgoingOffset += sent;
+        bytesSent += sent;
+    }
+
+    if (outgoingOffset == outgoing.size())
+    {
+        outgoing.clear();
+        outgoingOffset = 0;
+    }
+}
+
+void MultiplayerClient::updateView()
+{
+    const Net::WorldState& world = history[latestTick % Net::HISTORY_SIZE];
+
+    remotePlayers.clear();
+    for (int slot = 0; slot < Net::MAX_PLAYERS; ++slot)
+    {
+        const Net::PlayerState& state = world.players[slot];
+        if (!state.active || slot == playerId) continue;
+
+        double angle = Net::dequantizeAngle(state.angle);
+        remotePlayers.push_back({ Net::dequantizePosition(state.x), Net::dequantizePosition(state.y), Player::tileForAngle(angle) });
+    }
+
+    // The shots are moved to the server's current tick, estimated from when the snapshot arrived
+    double serverTick = latestTick + std::chrono::duration<double>(Clock::now() - latestTime).count() * tickRate;
+
+    shots.clear();
+    for (const Net::ShotState& shot : world.shots)
+    {
+        double x, y;
+        Net::shotPosition(shot, serverTick, tickRate, x, y);
+        if (x < 0 || x >= mapWidth || y < 0 || y >= mapHeight || map[int(y) * mapWidth + int(x)] == '#') continue;
+
+        shots.push_back(std::make_pair(x, y));
+    }
+}
+
+void MultiplayerClient::runBots(const std::string& path, int count, double duration)
+{
+    const double frameTime = 1.0 / 60.0;
+
+    std::vector<std::unique_ptr<MultiplayerClient>> bots;
+    for (int i = 0; i < count; ++i)
+    {
+        auto bot = std::make_unique<MultiplayerClient>();
+        if (!bot->connect(path))
+        {
+            std::fprintf(stderr, "Bot %d couldn't join %s\n", i, path.c_str());
+            continue;
+        }
+        bots.push_back(std::move(bot));
+    }
+
+    // Each bot holds a random input for a random time, like a player would
+    std::mt19937 generator(1234);
+    std::vector<InputState> inputs(bots.size());
+    std::vector<double> holdTimes(bots.size(), 0.0);
+
+    auto start = Clock::now();
+    auto nextFrame = start;
+    while (Clock::now() - start < std::chrono::duration<double>(duration))
+    {
+        for (std::size_t i = 0; i < bots.size(); ++i)
+        {
+            if ((holdTimes[i] -= frameTime) <= 0.0)
+            {
+                std::uint32_t bits = generator();
+                inputs[i] = InputState();
+                inputs[i].forward = bits & 1;
+                inputs[i].left = bits & 2 && !(bits & 4);
+                inputs[i].right = bits & 4 && !(bits & 2);
+                inputs[i].shoot = (bits & 24) == 24;
+                inputs[i].mouseDeltaX = int(bits >> 5 & 3) - 1;
+                holdTimes[i] = 0.1 + (bits >> 8 & 0xFF) / 255.0 * 0.5;
+            }
+            bots[i]->update(inputs[i], frameTime);
+        }
+
+        nextFrame += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frameTime));
+        std::this_thread::sleep_until(nextFrame);
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    for (std::size_t i = 0; i < bots.size(); ++i)
+    {
+        const MultiplayerClient& bot = *bots[i];
+        std::printf("Bot %d: %s, received %.0f B/s in %.1f snapshots/s, sent %.0f B/s, %zu corrections (%.4f cells on average)\n",
+            bot.getPlayerId(), bot.isConnected() ? "connected" : "disconnected", bot.getBytesReceived() / elapsed,
+            bot.getSnapshotCount() / elapsed, bot.getBytesSent() / elapsed, bot.getCorrectionCount(),
+            bot.getCorrectionCount() > 0 ? bot.getCorrectionDistance() / bot.getCorrectionCount() : 0.0);
+    }
+    std::fflush(stdout);
+}
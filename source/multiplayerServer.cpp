@@ -0,0 +1,383 @@
+/**
+ * @file multiplayerServer.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief MultiplayerServer class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "multiplayerServer.hpp"
+#include "maps.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+MultiplayerServer::MultiplayerServer(const Config& config) :
+    config(config), clients(std::clamp(config.maxPlayers, 1, Net::MAX_PLAYERS)), generator(config.seed)
+{
+    map = config.map.tiles;
+    mapWidth = config.map.width;
+    mapHeight = config.map.height;
+
+    // The map isn't edited in multiplayer, the clients would need the changes: doors stay closed
+    std::replace_if(map.begin(), map.end(), [](char tile) { return tile == 'D' || tile == '%'; }, '#');
+    freeCells.build(map, mapWidth);
+    connectivity.build(map, mapWidth, mapHeight);
+
+    // The players spawn at random cells and the objective is sent in the snapshots, so the markers are removed
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (map[i] == 'X')
+        {
+            objective.setX(i % mapWidth);
+            objective.setY(i / mapWidth);
+        }
+        if (map[i] != '#') map[i] = ' ';
+    }
+    objective.seed(config.seed + 1);
+
+    // The lamps don't block anything, so only the map sent to the clients keeps them, to light their screens
+    clientMap = map;
+    for (int i = 0; i < int(map.size()); ++i)
+    {
+        if (config.map.tiles[i] == 'o') clientMap[i] = 'o';
+    }
+}
+
+MultiplayerServer::~MultiplayerServer()
+{
+    for (Client& client : clients)
+    {
+        LocalSocket::close(client.socket);
+    }
+    LocalSocket::close(listener);
+}
+
+bool MultiplayerServer::run()
+{
+    if (!LocalSocket::initialize() || (listener = LocalSocket::listen(config.socketPath)) == LocalSocket::INVALID)
+    {
+        std::fprintf(stderr, "Couldn't listen on %s\n", config.socketPath.c_str());
+        return false;
+    }
+
+    std::printf("Multiplayer server for %d players on %s at %.0f ticks/s\n", int(clients.size()), config.socketPath.c_str(), config.tickRate);
+    std::fflush(stdout);
+
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.tickRate));
+    const auto start = Clock::now();
+    auto releaseTime = start;
+    auto lastReport = start;
+
+    while (config.duration <= 0.0 || Clock::now() - start < std::chrono::duration<double>(config.duration))
+    {
+        auto tickStart = Clock::now();
+
+        acceptClients();
+        for (int slot = 0; slot < int(clients.size()); ++slot)
+        {
+            if (clients[slot].socket != LocalSocket::INVALID) readCommands(slot);
+        }
+        simulate();
+        captureWorld();
+        sendSnapshots();
+
+        tickCosts.push_back(std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count());
+
+        double sinceReport = std::chrono::duration<double>(Clock::now() - lastReport).count();
+        if (config.reportInterval > 0.0 && sinceReport >= config.reportInterval)
+        {
+            report(sinceReport);
+            lastReport = Clock::now();
+        }
+
+        releaseTime = std::max(releaseTime + period, Clock::now());
+        std::this_thread::sleep_until(releaseTime);
+    }
+
+    if (config.reportInterval > 0.0) report(std::chrono::duration<double>(Clock::now() - lastReport).count());
+    return true;
+}
+
+void MultiplayerServer::acceptClients()
+{
+    for (LocalSocket::Handle socket = LocalSocket::accept(listener); socket != LocalSocket::INVALID;
+         socket = LocalSocket::accept(listener))
+    {
+        auto free = std::find_if(clients.begin(), clients.end(),
+            [](const Client& client) { return client.socket == LocalSocket::INVALID; });
+        if (free == clients.end())
+        {
+            LocalSocket::close(socket);
+            continue;
+        }
+
+        const int slot = int(free - clients.begin());
+        Client& client = *free;
+        client = Client();
+        client.socket = socket;
+        client.player.seed(config.seed + 2 + std::uint32_t(slot));
+
+        // Spawns at the center of a random empty cell
+        int cell = freeCells.sample(generator);
+        client.player.setX(cell % mapWidth + 0.5);
+        client.player.setY(cell / mapWidth + 0.5);
+        client.player.setAngle(PI / 2);
+        Net::snapPlayer(client.player);
+
+        std::size_t start = Net::beginMessage(client.outgoing, Net::MessageType::WELCOME);
+        Net::Writer writer(client.outgoing);
+        writer.u8(std::uint8_t(slot));
+        writer.u16(std::uint16_t(std::lround(config.tickRate * 100.0)));
+        writer.u32(std::uint32_t(mapWidth));
+        writer.u32(std::uint32_t(mapHeight));
+        Net::endMessage(client.outgoing, start);
+
+        // The map is sent as runs of the same tile, which the walls and corridors make short
+        const std::size_t maxChunk = Net::MAX_MESSAGE_SIZE - 16;   // Room for one more run
+        start = Net::beginMessage(client.outgoing, Net::MessageType::MAP);
+        for (std::size_t i = 0; i < clientMap.size();)
+        {
+            if (client.outgoing.size() - start > maxChunk)
+            {
+                Net::endMessage(client.outgoing, start);
+                start = Net::beginMessage(client.outgoing, Net::MessageType::MAP);
+            }
+
+            std::size_t run = 1;
+            while (i + run < clientMap.size() && clientMap[i + run] == clientMap[i]) run++;
+            writer.varint(std::uint32_t(run));
+            writer.u8(std::uint8_t(clientMap[i]));
+            i += run;
+        }
+        Net::endMessage(client.outgoing, start);
+
+        std::printf("Player %d joined\n", slot);
+        std::fflush(stdout);
+    }
+}
+
+void MultiplayerServer::readCommands(int slot)
+{
+    Client& client = clients[slot];
+
+    char buffer[4096];
+    int received;
+    while ((received = LocalSocket::receive(client.socket, buffer, int(sizeof(buffer)))) > 0)
+    {
+        client.incoming.append(buffer, received);
+        if (client.incoming.getBufferedBytes() > MAX_INCOMING_BYTES) break;
+    }
+
+    // Only a flooding client gets that far ahead of the ticks, and its bytes would pile up without end
+    if (received < 0 || client.incoming.getBufferedBytes() > MAX_INCOMING_BYTES)
+    {
+        disconnect(slot);
+        return;
+    }
+
+    const double tickMilliseconds = 1000.0 / config.tickRate;
+    client.timeBank = std::min(client.timeBank + tickMilliseconds, TIME_BANK_TICKS * tickMilliseconds);
+
+    Net::MessageType type;
+    std::string_view payload;
+    for (int count = 0; count < MAX_COMMANDS_PER_TICK && client.incoming.next(type, payload); ++count)
+    {
+        if (type != Net::MessageType::COMMAND) continue;
+
+        Net::Reader reader(payload);
+        std::uint32_t ackTick = reader.u32();
+        Net::Command command;
+        command.sequence = reader.u32();
+        command.buttons = reader.u8();
+        command.turn = std::int8_t(reader.u8());
+        command.milliseconds = reader.u8();
+        if (!reader.ok()) continue;
+
+        if (ackTick <= tick && ackTick > client.ackTick) client.ackTick = ackTick;
+        if (command.sequence <= client.lastSequence) continue;     // Already applied
+        if (command.milliseconds == 0 || command.milliseconds > Net::MAX_COMMAND_MILLISECONDS) continue;
+
+        // Past the bank, the command is cut short and the client's prediction is corrected
+        command.milliseconds = std::uint8_t(std::min<double>(command.milliseconds, client.timeBank));
+        client.timeBank -= command.milliseconds;
+
+        if (command.milliseconds > 0) Net::simulate(client.player, command, map, mapWidth, mapHeight);
+        if (command.buttons & Net::SHOOT) client.player.shoot();
+        client.lastSequence = command.sequence;
+    }
+
+    if (client.incoming.isMalformed()) disconnect(slot);
+}
+
+void MultiplayerServer::simulate()
+{
+    const double tickTime = 1.0 / config.tickRate;
+
+    for (Client& client : clients)
+    {
+        if (client.socket == LocalSocket::INVALID) continue;
+
+        client.player.updateShots(map, mapWidth, tickTime);
+        if (client.player.isAtPosition(int(objective.getX()), int(objective.getY())))
+        {
+            objective.randomizePosition(freeCells, connectivity, client.player.getX(), client.player.getY());
+        }
+    }
+}
+
+void MultiplayerServer::captureWorld()
+{
+    const Net::WorldState& previous = history[tick % Net::HISTORY_SIZE];
+    tick++;
+    Net::WorldState& world = history[tick % Net::HISTORY_SIZE];
+
+    world.tick = tick;
+    world.objectiveX = std::uint32_t(objective.getX());
+    world.objectiveY = std::uint32_t(objective.getY());
+    world.shots.clear();
+
+    for (int slot = 0; slot < Net::MAX_PLAYERS; ++slot)
+    {
+        Net::PlayerState& state = world.players[slot];
+        if (slot >= int(clients.size()) || clients[slot].socket == LocalSocket::INVALID)
+        {
+            state = Net::PlayerState();
+            continue;
+        }
+
+        const Player& player = clients[slot].player;
+        state.active = true;
+        state.x = Net::quantizePosition(player.getX());
+        state.y = Net::quantizePosition(player.getY());
+        state.angle = Net::quantizeAngle(player.getAngle());
+
+        for (const Shot& shot : player.getShots())
+        {
+            Net::ShotState shotState;
+            shotState.id = std::uint32_t(slot) << 24 | (shot.id & 0xFFFFFF);
+
+            // A known shot keeps the spawn it was first sent with, so it never changes in the deltas
+            auto known = std::lower_bound(previous.shots.begin(), previous.shots.end(), shotState.id,
+                [](const Net::ShotState& a, std::uint32_t id) { return a.id < id; });
+            if (known != previous.shots.end() && known->id == shotState.id)
+            {
+                world.shots.push_back(*known);
+                continue;
+            }
+
+            shotState.spawnTick = tick;
+            shotState.x = Net::quantizePosition(shot.x);
+            shotState.y = Net::quantizePosition(shot.y);
+            shotState.angle = Net::quantizeAngle(std::fmod(shot.angle + 2 * PI, 2 * PI));
+            shotState.speed = std::uint8_t(std::lround(shot.speed * 16.0));
+            world.shots.push_back(shotState);
+        }
+    }
+
+    std::sort(world.shots.begin(), world.shots.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+}
+
+const std::string& MultiplayerServer::encodedDelta(const Net::WorldState& baseline)
+{
+    for (auto& [baselineTick, delta] : encodedDeltas)
+    {
+        if (baselineTick == baseline.tick) return delta;
+    }
+
+    encodedDeltas.emplace_back(baseline.tick, std::string());
+    Net::encodeDelta(baseline, history[tick % Net::HISTORY_SIZE], encodedDeltas.back().second);
+    encodings++;
+    return encodedDeltas.back().second;
+}
+
+void MultiplayerServer::sendSnapshots()
+{
+    static const Net::WorldState emptyWorld;
+
+    encodedDeltas.clear();
+    for (int slot = 0; slot < int(clients.size()); ++slot)
+    {
+        Client& client = clients[slot];
+        if (client.socket == LocalSocket::INVALID) continue;
+
+        flush(client);
+        if (client.socket == LocalSocket::INVALID || client.outgoingOffset < client.outgoing.size()) continue;
+        client.outgoing.clear();
+        client.outgoingOffset = 0;
+
+        const Net::WorldState& acknowledged = history[client.ackTick % Net::HISTORY_SIZE];
+        bool hasBaseline = client.ackTick != 0 && tick - client.ackTick < Net::HISTORY_SIZE && acknowledged.tick == client.ackTick;
+        if (hasBaseline)    deltaSnapshots++;
+        else                fullSnapshots++;
+
+        std::size_t start = Net::beginMessage(client.outgoing, Net::MessageType::SNAPSHOT);
+        Net::Writer writer(client.outgoing);
+        writer.u32(client.lastSequence);
+        writer.bytes(encodedDelta(hasBaseline ? acknowledged : emptyWorld));
+        Net::endMessage(client.outgoing, start);
+
+        flush(client);
+    }
+}
+
+void MultiplayerServer::flush(Client& client)
+{
+    while (client.outgoingOffset < client.outgoing.size())
+    {
+        int sent = LocalSocket::send(client.socket, client.outgoing.data() + client.outgoingOffset,
+                                     int(client.outgoing.size() - client.outgoingOffset));
+        if (sent < 0)
+        {
+            disconnect(int(&client - clients.data()));
+            return;
+        }
+        if (sent == 0) return;  // Full, the rest goes in the next ticks
+
+        client.outgoingOffset += sent;
+        client.bytesSent += sent;
+    }
+}
+
+void MultiplayerServer::disconnect(int slot)
+{
+    LocalSocket::close(clients[slot].socket);
+    clients[slot] = Client();
+
+    std::printf("Player %d left\n", slot);
+    std::fflush(stdout);
+}
+
+void MultiplayerServer::report(double elapsed)
+{
+    if (tickCosts.empty() || elapsed <= 0.0) return;
+
+    int players = 0;
+    std::size_t bytes = 0;
+    for (Client& client : clients)
+    {
+        if (client.socket != LocalSocket::INVALID) players++;
+        bytes += client.bytesSent;
+        client.bytesSent = 0;
+    }
+
+    double sum = 0.0;
+    for (double cost : tickCosts) sum += cost;
+    double max = *std::max_element(tickCosts.begin(), tickCosts.end());
+
+    std::printf("Players %d | Shots %zu | Tick cost avg %.0f us, max %.0f us | %.0f B/s per player | Snapshots %zu delta, %zu full | %.2f encodings per tick\n",
+        players, history[tick % Net::HISTORY_SIZE].shots.size(), sum / tickCosts.size(), max,
+        players > 0 ? bytes / elapsed / players : 0.0, deltaSnapshots, fullSnapshots, double(encodings) / tickCosts.size());
+    std::fflush(stdout);
+
+    tickCosts.clear();
+    fullSnapshots = 0;
+    deltaSnapshots = 0;
+    encodings = 0;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file netProtocol.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Multiplayer protocol implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "netProtocol.hpp"
+#include "player.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Fields of a player in a delta
+constexpr std::uint8_t PLAYER_ACTIVE = 1 << 0;
+constexpr std::uint8_t PLAYER_X = 1 << 1;
+constexpr std::uint8_t PLAYER_Y = 1 << 2;
+constexpr std::uint8_t PLAYER_ANGLE = 1 << 3;
+
+constexpr std::uint8_t OBJECTIVE_CHANGED = 1 << 0;
+
+/**
+ * Maps a signed difference to an unsigned one, small magnitudes first (0, -1, 1, -2, ...), so it fits in a
+ * short varint.
+ */
+static std::uint32_t zigzag(std::int32_t value) { return (std::uint32_t(value) << 1) ^ std::uint32_t(value >> 31); }
+
+static std::int32_t unzigzag(std::uint32_t value) { return std::int32_t(value >> 1) ^ -std::int32_t(value & 1); }
+
+std::uint16_t Net::quantizeAngle(double angle)
+{
+    return std::uint16_t(std::lround(angle / (2 * PI) * 65536.0) & 0xFFFF);
+}
+
+double Net::dequantizeAngle(std::uint16_t angle)
+{
+    return angle / 65536.0 * 2 * PI;
+}
+
+void Net::snapPlayer(Player& player)
+{
+    player.setX(dequantizePosition(quantizePosition(player.getX())));
+    player.setY(dequantizePosition(quantizePosition(player.getY())));
+    player.setAngle(dequantizeAngle(quantizeAngle(player.getAngle())));
+    player.updateTile();
+}
+
+void Net::shotPosition(const ShotState& shot, double tick, double tickRate, double& x, double& y)
+{
+    double distance = (tick - shot.spawnTick) / tickRate * (shot.speed / 16.0);
+    double angle = dequantizeAngle(shot.angle);
+
+    x = dequantizePosition(shot.x) + std::cos(angle) * distance;
+    y = dequantizePosition(shot.y) - std::sin(angle) * distance;
+}
+
+Net::Command Net::makeCommand(const InputState& input, double frameTime, std::uint32_t sequence)
+{
+    Command command;
+    command.sequence = sequence;
+    command.milliseconds = std::uint8_t(std::clamp<long>(std::lround(frameTime * 1000.0), 1, MAX_COMMAND_MILLISECONDS));
+    command.turn = input.mouseDeltaX < 0 ? -1 : input.mouseDeltaX > 0 ? 1 : 0;
+
+    if (input.forward)   command.buttons |= FORWARD;
+    if (input.backward)  command.buttons |= BACKWARD;
+    if (input.left)      command.buttons |= LEFT;
+    if (input.right)     command.buttons |= RIGHT;
+    if (input.shoot)     command.buttons |= SHOOT;
+
+    return command;
+}
+
+InputState Net::toInput(const Command& command)
+{
+    InputState input;
+    input.forward = command.buttons & FORWARD;
+    input.backward = command.buttons & BACKWARD;
+    input.left = command.buttons & LEFT;
+    input.right = command.buttons & RIGHT;
+    input.shoot = command.buttons & SHOOT;
+    input.mouseDeltaX = command.turn;
+    return input;
+}
+
+void Net::simulate(Player& player, const Command& command, const std::string& map, int mapWidth, int mapHeight)
+{
+    player.applyMovement(toInput(command), command.milliseconds / 1000.0, map, mapWidth, mapHeight);
+    snapPlayer(player);
+}
+
+void Net::MessageBuffer::append(const char* bytes, int count)
+{
+    if (readOffset > 0)
+    {
+        data.erase(0, readOffset);
+        readOffset = 0;
+    }
+    data.append(bytes, count);
+}
+
+bool Net::MessageBuffer::next(MessageType& type, std::string_view& payload)
+{
+    while (!malformed)
+    {
+        std::size_t length = 0;
+        std::size_t header = 0;
+        std::uint8_t byte = 0x80;
+        while ((byte & 0x80) && header < LENGTH_BYTES)
+        {
+            if (readOffset + header == data.size()) return false;
+
+            byte = std::uint8_t(data[readOffset + header]);
+            length |= std::size_t(byte & 0x7F) << (7 * header);
+            header++;
+        }
+
+        // A last byte still continued means a longer length than any sent, and the next message can't be found
+        if (byte & 0x80)
+        {
+            malformed = true;
+            return false;
+        }
+        if (data.size() - readOffset - header < length) return false;
+
+        // A message without a type carries nothing
+        std::size_t start = readOffset + header;
+        readOffset = start + length;
+        if (length == 0) continue;
+
+        type = MessageType(data[start]);
+        payload = std::string_view(data).substr(start + 1, length - 1);
+        return true;
+    }
+    return false;
+}
+
+std::size_t Net::beginMessage(std::string& out, MessageType type)
+{
+    std::size_t start = out.size();
+    out.append(LENGTH_BYTES, '\0');     // The length, written by endMessage()
+    out += char(type);
+    return start;
+}
+
+bool Net::endMessage(std::string& out, std::size_t start)
+{
+    std::size_t length = out.size() - start - LENGTH_BYTES;
+    if (length > MAX_MESSAGE_SIZE)
+    {
+        out.resize(start);
+        return false;
+    }
+
+    // Room was left for the longest length, the bytes it doesn't use are removed
+    std::size_t used = 0;
+    while (length >= 0x80)
+    {
+        out[start + used++] = char((length & 0x7F) | 0x80);
+        length >>= 7;
+    }
+    out[start + used++] = char(length);
+    out.erase(start + used, LENGTH_BYTES - used);
+    return true;
+}
+
+void Net::encodeDelta(const WorldState& baseline, const WorldState& current, std::string& out)
+{
+    Writer writer(out);
+    writer.u32(current.tick);
+    writer.u32(baseline.tick);
+
+    bool objectiveChanged = current.objectiveX != baseline.objectiveX || current.objectiveY != baseline.objectiveY;
+    writer.u8(objectiveChanged ? OBJECTIVE_CHANGED : 0);
+    if (objectiveChanged)
+    {
+        writer.varint(current.objectiveX);
+        writer.varint(current.objectiveY);
+    }
+
+    // Players: only the changed fields, as differences from the baseline
+    std::uint8_t masks[MAX_PLAYERS];
+    std::uint32_t changedPlayers = 0;
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+    {
+        const PlayerState& before = baseline.players[i];
+        const PlayerState& after = current.players[i];
+
+        masks[i] = 0;
+        if (after.x != before.x)            masks[i] |= PLAYER_X;
+        if (after.y != before.y)            masks[i] |= PLAYER_Y;
+        if (after.angle != before.angle)    masks[i] |= PLAYER_ANGLE;
+        if (after.active != before.active || masks[i] != 0)
+        {
+            if (after.active) masks[i] |= PLAYER_ACTIVE;
+            changedPlayers++;
+        }
+    }
+
+    writer.varint(changedPlayers);
+    for (int i = 0; i < MAX_PLAYERS; ++i)
+    {
+        const PlayerState& before = baseline.players[i];
+        const PlayerState& after = current.players[i];
+        if (after.active == before.active && masks[i] == 0) continue;
+
+        writer.u8(std::uint8_t(i));
+        writer.u8(masks[i]);
+        if (masks[i] & PLAYER_X)        writer.varint(zigzag(std::int32_t(after.x - before.x)));
+        if (masks[i] & PLAYER_Y)        writer.varint(zigzag(std::int32_t(after.y - before.y)));
+        if (masks[i] & PLAYER_ANGLE)    writer.varint(zigzag(std::int16_t(after.angle - before.angle)));  // Wraps around
+    }
+
+    // Shots: the ids removed since the baseline and the shots added, both sorted lists merged in one pass
+    std::vector<std::uint32_t> removed;
+    std::vector<const ShotState*> added;
+    auto before = baseline.shots.begin();
+    auto after = current.shots.begin();
+    while (before != baseline.shots.end() || after != current.shots.end())
+    {
+        if (after == current.shots.end() || (before != baseline.shots.end() && before->id < after->id))
+        {
+            removed.push_back((before++)->id);
+        }
+        else if (before == baseline.shots.end() || after->id < before->id)
+        {
+            added.push_back(&*after++);
+        }
+        else if (after->spawnTick != before->spawnTick)
+        {
+            // The id was reused by a player who took a freed slot: replaced
+            removed.push_back((before++)->id);
+            added.push_back(&*after++);
+        }
+        else
+        {
+            ++before;
+            ++after;
+        }
+    }
+
+    writer.varint(std::uint32_t(removed.size()));
+    std::uint32_t previousId = 0;
+    for (std::uint32_t id : removed)
+    {
+        writer.varint(id - previousId);
+        previousId = id;
+    }
+
+    writer.varint(std::uint32_t(added.size()));
+    previousId = 0;
+    for (const ShotState* shot : added)
+    {
+        writer.varint(shot->id - previousId);
+        writer.varint(current.tick - shot->spawnTick);
+        writer.varint(shot->x);
+        writer.varint(shot->y);
+        writer.u16(shot->angle);
+        writer.u8(shot->speed);
+        previousId = shot->id;
+    }
+}
+
+bool Net::decodeDelta(const WorldState& baseline, std::uint32_t tick, Reader& reader, WorldState& result)
+{
+    result.tick = tick;
+    result.objectiveX = baseline.objectiveX;
+    result.objectiveY = baseline.objectiveY;
+    result.players = baseline.players;
+
+    if (reader.u8() & OBJECTIVE_CHANGED)
+    {
+        result.objectiveX = reader.varint();
+        result.objectiveY = reader.varint();
+    }
+
+    std::uint32_t changedPlayers = reader.varint();
+    for (std::uint32_t i = 0; i < changedPlayers && reader.ok(); ++i)
+    {
+        std::uint8_t slot = reader.u8();
+        std::uint8_t mask = reader.u8();
+        if (slot >= MAX_PLAYERS) return false;
+
+        PlayerState& player = result.players[slot];
+        player.active = mask & PLAYER_ACTIVE;
+        if (mask & PLAYER_X)        player.x = player.x + unzigzag(reader.varint());
+        if (mask & PLAYER_Y)        player.y = player.y + unzigzag(reader.varint());
+        if (mask & PLAYER_ANGLE)    player.angle = std::uint16_t(player.angle + unzigzag(reader.varint()));
+    }
+
+    std::vector<std::uint32_t> removed(std::min<std::uint32_t>(reader.varint(), MAX_MESSAGE_SIZE));
+    std::uint32_t previousId = 0;
+    for (std::uint32_t& id : removed)
+    {
+        id = previousId + reader.varint();
+        previousId = id;
+    }
+
+    std::vector<ShotState> added(std::min<std::uint32_t>(reader.varint(), MAX_MESSAGE_SIZE));
+    previousId = 0;
+    for (ShotState& shot : added)
+    {
+        shot.id = previousId + reader.varint();
+        shot.spawnTick = tick - reader.varint();
+        shot.x = reader.varint();
+        shot.y = reader.varint();
+        shot.angle = reader.u16();
+        shot.speed = reader.u8();
+        previousId = shot.id;
+    }
+    if (!reader.ok()) return false;
+
+    // Both lists are sorted by id, like the baseline's shots
+    result.shots.clear();
+    auto removedIt = removed.begin();
+    auto addedIt = added.begin();
+    for (const ShotState& shot : baseline.shots)
+    {
+        while (addedIt != added.end() && addedIt->id < shot.id) result.shots.push_back(*addedIt++);
+        while (removedIt != removed.end() && *removedIt < shot.id) ++removedIt;
+
+        if (removedIt != removed.end() && *removedIt == shot.id) continue;
+        result.shots.push_back(shot);
+    }
+    result.shots.insert(result.shots.end(), addedIt, added.end());
+
+    return true;
+}
@@ -10,34 +10,31 @@
 
 #include "objective.hpp"
 
-std::mt19937 gen(std::random_device{}());
-
-void Objective::randomizePosition(int mapWidth, int mapHeight, const std::string& map)
+void Objective::randomizePosition(const FreeCellIndex& freeCells, const ConnectivityIndex& connectivity, double playerX, double playerY,
+                                  double minDistance)
 {
-    bool isAtWall = true;
-    std::uniform_int_distribution<> disX(1, mapWidth - 2);
-    std::uniform_int_distribution<> disY(1, mapHeight - 2);
-    
-    while (isAtWall)
-    {
-        x = disX(gen);
-        y = disY(gen);
+    int cell = freeCells.sample(generator, playerX, playerY, minDistance, &connectivity);
+    if (cell < 0) return;
 
-        if (map[int(y) * mapWidth + int(x)] == ' ')
-        {
-            isAtWall = false;
-        }
-    }        
+    x = cell % freeCells.getMapWidth();
+    y = cell / freeCells.getMapWidth();
 }
 
-void Objective::randomizeWallTile(wchar_t& wallTile, double rayDistance)
+void Objective::randomizeWallTile(Glyph& wallTile, double rayDistance, int column, std::uint32_t frame)
 {
-    const wchar_t noiseChar = '\t';
-    std::uniform_int_distribution<> dis(0x1200, 0x137F); // Unicode range for ethiopic scripts
-    std::uniform_int_distribution<> dis2(1, int(rayDistance * rayDistance * rayDistance) + 10); 
+    const std::uint32_t firstGlyph = Glyphs::ETHIOPIC_FIRST;   // Unicode range for ethiopic scripts (0x1200 - 0x137F)
+    const std::uint32_t glyphCount = Glyphs::ETHIOPIC_COUNT;
+
+    // SplitMix64 finalizer. Source: https://prng.di.unimi.it/splitmix64.c
+    std::uint64_t hash = (std::uint64_t(frame) << 32 | std::uint32_t(column)) + 0x9E3779B97F4A7C15;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+    hash = hash ^ (hash >> 31);
 
-    const int random = dis2(gen);
+    // Each half of the hash is mapped to a range by multiplying and keeping the high bits (Lemire's method)
+    const std::uint32_t noiseRange = std::uint32_t(rayDistance * rayDistance * rayDistance) + 10;
+    const std::uint32_t glyph = firstGlyph + std::uint32_t(((hash & 0xFFFFFFFF) * glyphCount) >> 32);
+    const bool isNoise = (((hash >> 32) * noiseRange) >> 32) == 0;    // 1 in noiseRange, like before
 
-    if (random == 1)    wallTile = noiseChar;
-    else                wallTile = dis(gen); 
+    wallTile = isNoise ? Glyphs::NOISE : Glyph(glyph);
 }
\ No newline at end of file
@@ -61,28 +61,54 @@ void Player::rotate(Direction direction, double deltaTime)
     updateTile();
 }
 
+void Player::applyMovement(const InputState& input, double deltaTime, const std::string& map, int mapWidth, int mapHeight)
+{
+    double lastX = x;
+    double lastY = y;
+
+    if (input.forward)          move(Direction::UP, deltaTime);
+    if (input.backward)         move(Direction::DOWN, deltaTime);
+    if (input.left)             move(Direction::LEFT, deltaTime);
+    if (input.right)            move(Direction::RIGHT, deltaTime);
+    if (input.mouseDeltaX < 0)  rotate(Direction::LEFT, deltaTime);
+    if (input.mouseDeltaX > 0)  rotate(Direction::RIGHT, deltaTime);
+
+    int cellX = int(x);
+    int cellY = int(y);
+
+    if (cellX <= 0 || cellX >= mapWidth ||
+        cellY <= 0 || cellY >= mapHeight ||
+        map[cellY * mapWidth + cellX] == '#')
+    {
+        x = lastX;
+        y = lastY;
+    }
+}
+
 void Player::shoot()
 {
-    static auto lastShotTime = std::chrono::high_resolution_clock::now();
     auto currentTime = std::chrono::high_resolution_clock::now();
     double elapsedTime = std::chrono::duration<double>(currentTime - lastShotTime).count();
 
     if (elapsedTime > 0.3)
     {
-        double shotAngle = angle + (rand() % 100 - 50) / 1000.0; // Add a random angle between -0.05 and 0.05 radians to the shot
+        double shotAngle = angle + (int(generator() % 100) - 50) / 1000.0; // Add a random angle between -0.05 and 0.05 radians to the shot
         Shot shot(x, y, shotAngle, speed + 4.0);
+        shot.id = nextShotId++;
         shots.push_back(shot);
         lastShotTime = currentTime;
     }  
 }
 
-void Player::updateShots(const std::string& map, int mapWidth, double deltaTime)
+void Player::updateShots(const std::string& map, int mapWidth, double deltaTime, std::vector<int>* hitWalls)
 {
     for (auto it = shots.begin(); it != shots.end();)
     {
         it->move(deltaTime);
-        if (map[int(it->y) * mapWidth + int(it->x)] == '#')
+        const int cell = int(it->y) * mapWidth + int(it->x);
+        if (map[cell] == '#')
         {
+            if (hitWalls) hitWalls->push_back(cell);
             it = shots.erase(it); // erase returns the iterator to the next element
         }
         else
@@ -92,12 +118,12 @@ void Player::updateShots(const std::string& map, int mapWidth, double deltaTime)
     }
 }
 
-void Player::updateTile()
+char Player::tileForAngle(double angle)
 {
-    if (angle >= 7 * PI / 4 || angle < PI / 4)      tile = '>';
-    else if (angle < 3 * PI / 4)                    tile = '^';
-    else if (angle < 5 * PI / 4)                    tile = '<';
-    else if (angle < 7 * PI / 4)                    tile = 'v';
+    if (angle >= 7 * PI / 4 || angle < PI / 4)      return '>';
+    else if (angle < 3 * PI / 4)                    return '^';
+    else if (angle < 5 * PI / 4)                    return '<';
+    else                                            return 'v';
 }
 
 void Player::increaseFOV(double deltaTime)
@@ -9,70 +9,288 @@
  */
 
 #include "ray.hpp"
-#include <algorithm>
 
-void Ray::castRay(double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RAY_PACKETS
+#include <immintrin.h>
+#endif
+
+void Ray::castRay(double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                  bool testObjective)
 {
     int newX = int(playerX);
     int newY = int(playerY);
 
     bool hit = false;
+    const double dirX = cos(angle);
+    const double dirY = sin(angle);
 
     while (!hit && distance < maxDepth)
     {
-        distance += 0.1;
+        distance += nextStep();
 
-        newX = int(playerX + distance * cos(angle));    // Formula: X = X0 + t * Dx. Source: https://en.wikipedia.org/wiki/Ray_casting. 
-        newY = int(playerY - distance * sin(angle));    // X0 is the initial position, t is the parameter (distance here), and Dx is 
-                                                        // the direction vector.
+        newX = int(playerX + distance * dirX);  // Formula: X = X0 + t * Dx. Source: https://en.wikipedia.org/wiki/Ray_casting. 
+        newY = int(playerY - distance * dirY);  // X0 is the initial position, t is the parameter (distance here), and Dx is 
+                                                // the direction vector.
 
-        if (newX < 0 || newX >= mapWidth || newY < 0 || newY >= mapHeight)
+        hit = hitsCell(newX, newY, playerX, playerY, dirX, -dirY, mapWidth, mapHeight, map, objective, testObjective);
+    }
+}
+
+bool Ray::hitsCell(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY, int mapWidth, int mapHeight, const std::string& map,
+                   const Objective& objective, bool testObjective)
+{
+    if (mapX < 0 || mapX >= mapWidth || mapY < 0 || mapY >= mapHeight)
+    {
+        hitWall = true;
+        hitFraction = computeHitFraction(mapX, mapY, playerX, playerY, dirX, dirY);
+        return true;
+    } 
+    else if (map[mapY * mapWidth + mapX] == '#')
+    {
+        hitWall = true;
+        hitCell = mapY * mapWidth + mapX;
+        hitFraction = computeHitFraction(mapX, mapY, playerX, playerY, dirX, dirY);
+        verifyBoundary(mapX, mapY, playerX, playerY, dirX, dirY);
+        return true;
+    }
+    else if (testObjective && mapX == int(objective.getX()) && mapY == int(objective.getY()))
+    {
+        hitObjective = true;
+        verifyBoundary(mapX, mapY, playerX, playerY, dirX, dirY);
+        return true;
+    }
+    return false;
+}
+
+double Ray::computeHitFraction(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY) const
+{
+    // The distances at which the ray crosses the near vertical and horizontal sides of the cell. It enters
+    // the cell through the one it crosses last
+    const double toVertical = dirX > 0.0 ? (mapX - playerX) / dirX : dirX < 0.0 ? (mapX + 1 - playerX) / dirX : -INFINITY;
+    const double toHorizontal = dirY > 0.0 ? (mapY - playerY) / dirY : dirY < 0.0 ? (mapY + 1 - playerY) / dirY : -INFINITY;
+
+    const double along = toVertical > toHorizontal ? playerY + toVertical * dirY : playerX + toHorizontal * dirX;
+    return along - std::floor(along);
+}
+
+void Ray::castRays(Ray* rays, int count, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                   bool testObjective)
+{
+    // Packets need fresh rays with the same depth and level of detail, since all their lanes march the same distance
+    auto isPacketReady = [rays](int first, int lanes) {
+        for (int i = first; i < first + lanes; i++)
         {
-            hit = true;
-            this->hitWall = true;
-        } 
-        else if (map[newY * mapWidth + newX] == '#')
+            if (rays[i].distance != 0.0 || rays[i].maxDepth != rays[first].maxDepth ||
+                rays[i].lodDistance != rays[first].lodDistance || rays[i].farStep != rays[first].farStep) return false;
+        }
+        return true;
+    };
+
+    int i = 0;
+
+    #ifdef RAY_PACKETS
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+    if (hasAVX2)
+    {
+        for (; i + 4 <= count; i += 4)
         {
-            hit = true;
-            this->hitWall = true;
-            verifyBoundary(newX, newY, playerX, playerY);
+            if (isPacketReady(i, 4))    castPacketAVX2(rays + i, playerX, playerY, mapWidth, mapHeight, map, objective, testObjective);
+            else                        break;
         }
-        else if (newX == int(objective.getX()) && newY == int(objective.getY()))
+    }
+    for (; i + 2 <= count; i += 2)
+    {
+        if (isPacketReady(i, 2))        castPacketSSE2(rays + i, playerX, playerY, mapWidth, mapHeight, map, objective, testObjective);
+        else                            break;
+    }
+    #endif
+
+    for (; i < count; i++)
+    {
+        rays[i].castRay(playerX, playerY, mapWidth, mapHeight, map, objective, testObjective);
+    }
+}
+
+#ifdef RAY_PACKETS
+
+// The lanes are doubles, not floats, so every lane computes exactly the same cells as castRay. The distance 
+// is the same in all lanes (they all start at 0 and step 0.1), only the direction changes between them.
+// Each step tests the cells of all the lanes at once, and only the lanes that stop go through hitsCell.
+
+__attribute__((target("avx2")))
+void Ray::castPacketAVX2(Ray* rays, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                         bool testObjective)
+{
+    alignas(32) double cosines[4];
+    alignas(32) double sines[4];
+    alignas(16) int cellsX[4];
+    alignas(16) int cellsY[4];
+    alignas(16) int cells[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        cosines[i] = cos(rays[i].angle);
+        sines[i] = sin(rays[i].angle);
+    }
+
+    const __m256d dirX = _mm256_load_pd(cosines);
+    const __m256d dirY = _mm256_load_pd(sines);
+    const __m256d originX = _mm256_set1_pd(playerX);
+    const __m256d originY = _mm256_set1_pd(playerY);
+    const double maxDepth = rays[0].maxDepth;
+    const __m128i width = _mm_set1_epi32(mapWidth);
+    const __m128i height = _mm_set1_epi32(mapHeight);
+    const __m128i minusOne = _mm_set1_epi32(-1);
+    const __m128i wall = _mm_set1_epi32('#');
+    const __m128i objectiveX = _mm_set1_epi32(testObjective ? int(objective.getX()) : -1);   // -1 is outside, stopped anyway
+    const __m128i objectiveY = _mm_set1_epi32(testObjective ? int(objective.getY()) : -1);
+    const char* tilesData = map.data();
+
+    Ray stepper = rays[0];  // Only used to step the distance shared by the lanes
+    double& distance = stepper.distance;
+    int activeLanes = 0b1111;
+
+    while (activeLanes && distance < maxDepth)
+    {
+        distance += stepper.nextStep();
+
+        const __m256d t = _mm256_set1_pd(distance);
+        const __m128i x = _mm256_cvttpd_epi32(_mm256_add_pd(originX, _mm256_mul_pd(t, dirX)));
+        const __m128i y = _mm256_cvttpd_epi32(_mm256_sub_pd(originY, _mm256_mul_pd(t, dirY)));
+
+        // The lanes that stop here: outside the map, on a wall or on the objective. Outside lanes read cell 0
+        const __m128i inside = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(x, minusOne), _mm_cmpgt_epi32(width, x)),
+                                             _mm_and_si128(_mm_cmpgt_epi32(y, minusOne), _mm_cmpgt_epi32(height, y)));
+        _mm_store_si128((__m128i*)cells, _mm_and_si128(inside, _mm_add_epi32(_mm_mullo_epi32(y, width), x)));
+        const __m128i tiles = _mm_setr_epi32(tilesData[cells[0]], tilesData[cells[1]], tilesData[cells[2]], tilesData[cells[3]]);
+        const __m128i stops = _mm_or_si128(_mm_andnot_si128(inside, minusOne),
+                                           _mm_or_si128(_mm_cmpeq_epi32(tiles, wall), _mm_and_si128(_mm_cmpeq_epi32(x, objectiveX), _mm_cmpeq_epi32(y, objectiveY))));
+
+        int stoppedLanes = _mm_movemask_ps(_mm_castsi128_ps(stops)) & activeLanes;
+        if (stoppedLanes == 0) continue;
+
+        _mm_store_si128((__m128i*)cellsX, x);
+        _mm_store_si128((__m128i*)cellsY, y);
+        for (int i = 0; i < 4; i++)
         {
-            hit = true;
-            this->hitObjective = true;
-            verifyBoundary(newX, newY, playerX, playerY);
+            if ((stoppedLanes & (1 << i)) && rays[i].hitsCell(cellsX[i], cellsY[i], playerX, playerY, cosines[i], -sines[i], mapWidth, mapHeight, map,
+                                                              objective, testObjective))
+            {
+                rays[i].distance = distance;
+                activeLanes &= ~(1 << i);
+            }
         }
     }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (activeLanes & (1 << i)) rays[i].distance = distance;
+    }
 }
 
-void Ray::verifyBoundary(int mapX, int mapY, double playerX, double playerY)
+void Ray::castPacketSSE2(Ray* rays, double playerX, double playerY, int mapWidth, int mapHeight, const std::string& map, const Objective& objective,
+                         bool testObjective)
 {
-    // Source: https://github.com/OneLoneCoder/CommandLineFPS
+    alignas(16) double cosines[2];
+    alignas(16) double sines[2];
+    alignas(16) int cells[4];
+
+    for (int i = 0; i < 2; i++)
+    {
+        cosines[i] = cos(rays[i].angle);
+        sines[i] = sin(rays[i].angle);
+    }
+
+    const __m128d dirX = _mm_load_pd(cosines);
+    const __m128d dirY = _mm_load_pd(sines);
+    const __m128d originX = _mm_set1_pd(playerX);
+    const __m128d originY = _mm_set1_pd(playerY);
+    const double maxDepth = rays[0].maxDepth;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lastCell = _mm_setr_epi32(mapWidth - 1, mapWidth - 1, mapHeight - 1, mapHeight - 1);
+    const __m128i wall = _mm_set1_epi32('#');
+    const int objectiveX = testObjective ? int(objective.getX()) : -1;   // -1 is outside, stopped anyway
+    const int objectiveY = testObjective ? int(objective.getY()) : -1;
+    const __m128i objectiveXY = _mm_setr_epi32(objectiveX, objectiveX, objectiveY, objectiveY);
+    const char* tilesData = map.data();
 
-    std::vector<std::pair<double, double>> p;
+    Ray stepper = rays[0];  // Only used to step the distance shared by the lanes
+    double& distance = stepper.distance;
+    int activeLanes = 0b11;
 
-    for (int tx = 0; tx < 2; tx++)
+    while (activeLanes && distance < maxDepth)
     {
-        for (int ty = 0; ty < 2; ty++)
+        distance += stepper.nextStep();
+
+        // Both lanes of x and y are packed in one register: { x0, x1, y0, y1 }
+        const __m128d t = _mm_set1_pd(distance);
+        const __m128i x = _mm_cvttpd_epi32(_mm_add_pd(originX, _mm_mul_pd(t, dirX)));
+        const __m128i y = _mm_cvttpd_epi32(_mm_sub_pd(originY, _mm_mul_pd(t, dirY)));
+        const __m128i xy = _mm_unpacklo_epi64(x, y);
+        _mm_store_si128((__m128i*)cells, xy);
+
+        // The lanes that stop here: outside the map, on a wall or on the objective. SSE2 has no 32-bit
+        // multiply, so the indices of the cells are computed apart
+        const __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(zero, xy), _mm_cmpgt_epi32(xy, lastCell));
+        const bool inside0 = (_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0b0101) == 0;
+        const bool inside1 = (_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0b1010) == 0;
+        const __m128i tiles = _mm_setr_epi32(inside0 ? tilesData[cells[2] * mapWidth + cells[0]] : 0, inside1 ? tilesData[cells[3] * mapWidth + cells[1]] : 0, 0, 0);
+        const __m128i onObjective = _mm_cmpeq_epi32(xy, objectiveXY);
+        const __m128i stops = _mm_or_si128(_mm_cmpeq_epi32(tiles, wall), _mm_and_si128(onObjective, _mm_shuffle_epi32(onObjective, _MM_SHUFFLE(1, 0, 3, 2))));
+
+        const int stoppedLanes = ((_mm_movemask_ps(_mm_castsi128_ps(stops)) & 0b11) | (!inside0) | (!inside1 << 1)) & activeLanes;
+        if (stoppedLanes == 0) continue;
+
+        for (int i = 0; i < 2; i++)
         {
-            // Angle of corner to eye
-            double vy = (double)mapY + ty - playerY;
-            double vx = (double)mapX + tx - playerX;
-            double d = sqrt(vx * vx + vy * vy);
-            double dot = (cos(angle) * vx / d) + (-sin(angle) * vy / d);
-            p.push_back(std::make_pair(d, dot));
+            if ((stoppedLanes & (1 << i)) && rays[i].hitsCell(cells[i], cells[2 + i], playerX, playerY, cosines[i], -sines[i], mapWidth, mapHeight, map,
+                                                              objective, testObjective))
+            {
+                rays[i].distance = distance;
+                activeLanes &= ~(1 << i);
+            }
         }
     }
 
-    // Sort Pairs from closest to farthest
-    sort(p.begin(), p.end(), [](const std::pair<double, double>& left, const std::pair<double, double>& right) {return left.first < right.first; });
+    for (int i = 0; i < 2; i++)
+    {
+        if (activeLanes & (1 << i)) rays[i].distance = distance;
+    }
+}
+
+#endif // RAY_PACKETS
+
+void Ray::verifyBoundary(int mapX, int mapY, double playerX, double playerY, double dirX, double dirY)
+{
+    // Source: https://github.com/OneLoneCoder/CommandLineFPS
+
+    // The ray is at an edge when the angle between it and the direction of a corner is lower than the bound, 
+    // i.e. acos(dot / d) < bound. It is the same as dot > cos(bound) * d, and squaring both sides (dot must be 
+    // positive) there is no need for sqrt or acos.
+    static const double bound = 0.01;
+    static const double cosBoundSquared = cos(bound) * cos(bound);
 
-    // First two/three are closest (we will never see all four)
-    double bound = 0.01;    
-    if (acos(p.at(0).second) < bound) hitBoundary = true;
-    if (acos(p.at(1).second) < bound) hitBoundary = true;
-    if (acos(p.at(2).second) < bound) hitBoundary = true;
+    double distanceSquared[4];
+    double dot[4];
+    int farthest = 0;
+
+    for (int i = 0; i < 4; i++)
+    {
+        // Corner to eye
+        double vx = (double)mapX + (i >> 1) - playerX;
+        double vy = (double)mapY + (i & 1) - playerY;
+        distanceSquared[i] = vx * vx + vy * vy;
+        dot[i] = dirX * vx + dirY * vy;
+        if (distanceSquared[i] > distanceSquared[farthest]) farthest = i;
+    }
+
+    // The three closest corners are tested (we will never see all four)
+    for (int i = 0; i < 4; i++)
+    {
+        if (i != farthest && dot[i] > 0 && dot[i] * dot[i] > cosBoundSquared * distanceSquared[i]) hitBoundary = true;
+    }
 }
 
 void Ray::castRayDDA(double playerX, double playerY, std::vector<std::string> map)
@@ -0,0 +1,49 @@
+/**
+ * @file renderQuality.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief RenderQuality class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "renderQuality.hpp"
+
+void RenderQuality::update(double frameTime)
+{
+    // Exponential moving average, so a single slow frame doesn't change the level
+    const double smoothing = 0.1;
+    averageFrameTime += (frameTime - averageFrameTime) * smoothing;
+
+    if (targetFrameTime == 0.0) return;
+
+    const int framesToRaise = 60;
+    const double raiseThreshold = 0.6;  // Only raise if the frames take less than 60% of the budget
+    const int cooldown = 30;            // About 3 time constants of the average, so it mostly reflects the new level
+
+    if (cooldownFrames > 0)
+    {
+        cooldownFrames--;
+        framesUnderBudget = 0;
+    }
+    else if (averageFrameTime > targetFrameTime && level < LEVEL_COUNT - 1)
+    {
+        level++;
+        framesUnderBudget = 0;
+        cooldownFrames = cooldown;
+    }
+    else if (averageFrameTime < targetFrameTime * raiseThreshold && level > 0)
+    {
+        if (++framesUnderBudget >= framesToRaise)
+        {
+            level--;
+            framesUnderBudget = 0;
+            cooldownFrames = cooldown;
+        }
+    }
+    else
+    {
+        framesUnderBudget = 0;
+    }
+}
@@ -0,0 +1,122 @@
+/**
+ * @file scheduler.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief WorkStealingScheduler class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "scheduler.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+
+thread_local int WorkStealingScheduler::workerIndex = -1;
+
+WorkStealingScheduler::WorkStealingScheduler(int threadCount)
+{
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 0; i < threadCount; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (int i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back(&WorkStealingScheduler::workerLoop, this, i);
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingScheduler::submit(Task task)
+{
+    int index = workerIndex >= 0 ? workerIndex : int(nextQueue++ % workers.size());
+
+    pendingTasks++;
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Taken so a worker can't miss the increment between checking it and going to sleep
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks++;
+    }
+    wakeUp.notify_one();
+}
+
+void WorkStealingScheduler::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    idle.wait(lock, [this]() { return pendingTasks == 0; });
+}
+
+bool WorkStealingScheduler::popOwn(int index, Task& task)
+{
+    Worker& worker = *workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) return false;
+
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingScheduler::steal(int thief, Task& task)
+{
+    const int count = int(workers.size());
+    for (int offset = 1; offset < count; ++offset)
+    {
+        Worker& victim = *workers[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingScheduler::workerLoop(int index)
+{
+    workerIndex = index;
+    insideParallelFor = true;   // The pool already uses every core, parallel loops in the tasks run inline
+
+    Task task;
+    while (true)
+    {
+        if (popOwn(index, task) || steal(index, task))
+        {
+            queuedTasks--;
+            task();
+            task = nullptr;     // Releases the captures before reporting the task as done
+
+            if (--pendingTasks == 0)
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+        if (stopping && queuedTasks == 0) return;
+    }
+}
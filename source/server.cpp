@@ -0,0 +1,272 @@
+/**
+ * @file server.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief SessionServer class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "server.hpp"
+#include <algorithm>
+#include <cstdio>
+
+using Clock = std::chrono::steady_clock;
+
+SessionServer::SessionServer(const Config& config) :
+    config(config), sessions(std::max(0, config.sessionCount)), scheduler(config.threadCount)
+{
+    // Sequential, so the first session builds the shared tables of the map with every core and the others reuse them
+    for (int i = 0; i < int(sessions.size()); ++i)
+    {
+        sessions[i] = std::make_unique<Session>(config.map);
+        sessions[i]->game.seed(config.seed + 2 * std::uint32_t(i));    // Player and objective use seed and seed + 1
+        if (config.configureGame) config.configureGame(sessions[i]->game);
+        sessions[i]->screen.assign(sessions[i]->game.getScreenWidth() * sessions[i]->game.getScreenHeight(), Glyph(' '));
+    }
+}
+
+SessionServer::~SessionServer()
+{
+    for (auto& session : sessions)
+    {
+        LocalSocket::close(session->client);
+    }
+    for (LocalSocket::Handle client : waitingClients)
+    {
+        LocalSocket::close(client);
+    }
+    LocalSocket::close(listener);
+}
+
+bool SessionServer::run()
+{
+    if (!LocalSocket::initialize() || (listener = LocalSocket::listen(config.socketPath)) == LocalSocket::INVALID)
+    {
+        std::fprintf(stderr, "Couldn't listen on %s\n", config.socketPath.c_str());
+        return false;
+    }
+
+    std::printf("Serving %d sessions on %s at %.0f ticks/s with %d threads\n",
+        int(sessions.size()), config.socketPath.c_str(), config.tickRate, scheduler.getThreadCount());
+    std::fflush(stdout);
+
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / config.tickRate));
+    const auto start = Clock::now();
+    auto lastReport = start;
+    for (auto& session : sessions)
+    {
+        session->releaseTime = start;
+        session->previousRelease = start - period;
+    }
+
+    while (config.duration <= 0.0 || Clock::now() - start < std::chrono::duration<double>(config.duration))
+    {
+        acceptClients();
+
+        // Submits the idle sessions that are due; the busy ones schedule their next tick when they end
+        const auto now = Clock::now();
+        auto wakeTime = now + period;
+        for (auto& session : sessions)
+        {
+            if (session->busy.load(std::memory_order_acquire)) continue;
+
+            if (session->releaseTime > now)
+            {
+                wakeTime = std::min(wakeTime, session->releaseTime);
+                continue;
+            }
+
+            Session* target = session.get();
+            target->busy.store(true, std::memory_order_relaxed);
+            scheduler.submit([this, target]() { tick(*target); });
+        }
+
+        if (config.reportInterval > 0.0 && now - lastReport >= std::chrono::duration<double>(config.reportInterval))
+        {
+            report();
+            lastReport = now;
+        }
+
+        // Woken early when a session ends a tick, since its next one may be due before wakeTime
+        std::unique_lock<std::mutex> lock(tickMutex);
+        tickEnded.wait_until(lock, wakeTime, [this]() { return tickEndedFlag; });
+        tickEndedFlag = false;
+    }
+
+    scheduler.waitIdle();
+    if (config.reportInterval > 0.0) report();
+    return true;
+}
+
+void SessionServer::acceptClients()
+{
+    for (LocalSocket::Handle client = LocalSocket::accept(listener); client != LocalSocket::INVALID;
+         client = LocalSocket::accept(listener))
+    {
+        if (attachedClients + int(waitingClients.size()) >= int(sessions.size()))
+        {
+            const char message[] = "Server full\r\n";
+            LocalSocket::send(client, message, int(sizeof(message) - 1));
+            LocalSocket::close(client);
+            continue;
+        }
+        waitingClients.push_back(client);
+    }
+
+    // Only idle sessions are attached, a busy one belongs to its tick
+    while (!waitingClients.empty())
+    {
+        auto free = std::find_if(sessions.begin(), sessions.end(), [](const auto& session) {
+            return !session->busy.load(std::memory_order_acquire) && session->client == LocalSocket::INVALID;
+        });
+        if (free == sessions.end()) break;
+
+        (*free)->client = waitingClients.front();
+        (*free)->frame.clear();
+        (*free)->frameOffset = 0;
+        waitingClients.erase(waitingClients.begin());
+        attachedClients++;
+        std::printf("Client attached to session %d\n", int(free - sessions.begin()));
+        std::fflush(stdout);
+    }
+}
+
+void SessionServer::detach(Session& session)
+{
+    if (session.client != LocalSocket::INVALID) attachedClients--;
+    LocalSocket::close(session.client);
+    session.client = LocalSocket::INVALID;
+    session.input = InputState();
+}
+
+void SessionServer::readClient(Session& session)
+{
+    // Terminals don't report key releases, so a key acts in the ticks it is received (held keys repeat)
+    session.input = InputState();
+    if (session.client == LocalSocket::INVALID) return;
+
+    char keys[256];
+    int received;
+    while ((received = LocalSocket::receive(session.client, keys, int(sizeof(keys)))) > 0)
+    {
+        for (int i = 0; i < received; ++i)
+        {
+            switch (keys[i])
+            {
+                case 'w': session.input.forward = true;     break;
+                case 's': session.input.backward = true;    break;
+                case 'a': session.input.left = true;        break;
+                case 'd': session.input.right = true;       break;
+                case 'j': session.input.mouseDeltaX = -1;   break;
+                case 'l': session.input.mouseDeltaX = 1;    break;
+                case ' ': session.input.shoot = true;       break;
+                case 'q': session.input.zoom = true;        break;
+                case 'e': session.input.toggleFOV = true;   break;
+                case 'm': session.input.toggleMap = true;   break;
+                case 'p': session.input.togglePath = true;  break;
+                case 'f': session.input.use = true;         break;
+                case 'x': detach(session);                  return;
+                default:                                    break;
+            }
+        }
+    }
+
+    if (received < 0) detach(session);
+}
+
+void SessionServer::sendFrame(Session& session)
+{
+    if (session.client == LocalSocket::INVALID) return;
+
+    if (session.frameOffset == session.frame.size())
+    {
+        const int width = session.game.getScreenWidth();
+        const int height = session.game.getScreenHeight();
+
+        session.frame.assign("\x1b[H");
+        for (int y = 0; y < height; ++y)
+        {
+            Glyphs::appendUtf8(session.frame, session.screen.data() + y * width, width);
+            if (y + 1 < height) session.frame += "\r\n";
+        }
+        session.frameOffset = 0;
+    }
+
+    int sent = LocalSocket::send(session.client, session.frame.data() + session.frameOffset,
+                                 int(session.frame.size() - session.frameOffset));
+    if (sent < 0)   detach(session);
+    else            session.frameOffset += sent;
+}
+
+void SessionServer::tick(Session& session)
+{
+    const double frameTime = std::chrono::duration<double>(session.releaseTime - session.previousRelease).count();
+    readClient(session);
+    session.game.update(session.input, frameTime);
+    session.game.render(session.screen.data());
+    sendFrame(session);
+
+    const auto now = Clock::now();
+    double latency = std::chrono::duration<double, std::micro>(now - session.releaseTime).count();
+    {
+        std::lock_guard<std::mutex> lock(session.latencyMutex);
+        session.latencies.push_back(latency);
+        session.maxLatency = std::max(session.maxLatency, latency);
+    }
+
+    session.previousRelease = session.releaseTime;
+    session.releaseTime = std::max(session.releaseTime + period, now);
+    session.busy.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(tickMutex);
+        tickEndedFlag = true;
+    }
+    tickEnded.notify_one();
+}
+
+void SessionServer::report()
+{
+    std::vector<double> all;
+    std::vector<std::pair<double, int>> slowest;    // (p99, session)
+    std::vector<double> maxLatencies(sessions.size(), 0.0);
+
+    for (int i = 0; i < int(sessions.size()); ++i)
+    {
+        // Taken out under the lock, since the session may be ticking
+        Session& session = *sessions[i];
+        std::vector<double> latencies;
+        {
+            std::lock_guard<std::mutex> lock(session.latencyMutex);
+            latencies.swap(session.latencies);
+            maxLatencies[i] = session.maxLatency;
+            session.maxLatency = 0.0;
+        }
+        if (latencies.empty()) continue;
+
+        auto p99 = latencies.begin() + (latencies.size() * 99) / 100;
+        std::nth_element(latencies.begin(), p99, latencies.end());
+        slowest.push_back(std::make_pair(*p99, i));
+
+        all.insert(all.end(), latencies.begin(), latencies.end());
+    }
+    if (all.empty()) return;
+
+    double sum = 0.0;
+    for (double latency : all) sum += latency;
+    auto p99 = all.begin() + (all.size() * 99) / 100;
+    std::nth_element(all.begin(), p99, all.end());
+    double max = *std::max_element(all.begin(), all.end());
+
+    std::printf("Ticks %zu | Sessions %d | Clients %d | Latency avg %.0f us, p99 %.0f us, max %.0f us\n",
+        all.size(), int(sessions.size()), attachedClients.load(), sum / all.size(), *p99, max);
+
+    const int shown = std::min<int>(5, int(slowest.size()));
+    std::partial_sort(slowest.begin(), slowest.begin() + shown, slowest.end(), std::greater<>());
+    for (int i = 0; i < shown; ++i)
+    {
+        std::printf("  Session %d: p99 %.0f us, max %.0f us\n", slowest[i].second, slowest[i].first, maxLatencies[slowest[i].second]);
+    }
+    std::fflush(stdout);
+}
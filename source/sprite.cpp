@@ -0,0 +1,85 @@
+/**
+ * @file sprite.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief SpriteRenderer class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "sprite.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpriteRenderer::SpriteRenderer(int screenWidth, int screenHeight) :
+    depthBuffer(screenWidth, 0.0), screenWidth(screenWidth), screenHeight(screenHeight)
+{
+    sprites.reserve(MAX_SPRITES);
+    order.reserve(MAX_SPRITES);
+}
+
+void SpriteRenderer::render(Glyph* screen, double cameraX, double cameraY, double cameraAngle, double fov, double maxDistance)
+{
+    const double minDistance = 0.3;     // Closer sprites would cover the whole screen
+
+    order.clear();
+    for (int i = 0; i < int(sprites.size()); ++i)
+    {
+        double dx = sprites[i].x - cameraX;
+        double dy = sprites[i].y - cameraY;
+        double distanceSquared = dx * dx + dy * dy;
+        if (distanceSquared < minDistance * minDistance || distanceSquared >= maxDistance * maxDistance) continue;
+
+        order.push_back(std::make_pair(distanceSquared, i));
+    }
+
+    // Back to front, so the closest sprites are drawn over the farthest ones
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    for (auto& [distanceSquared, index] : order)
+    {
+        const Sprite& sprite = sprites[index];
+        const double distance = std::sqrt(distanceSquared);
+
+        // Same projection as the rays: column x looks at angle + fov / 2 - x / screenWidth * fov. The y-axis
+        // of the map points down, hence the minus.
+        double spriteAngle = std::atan2(-(sprite.y - cameraY), sprite.x - cameraX);
+        double angleFromCenter = std::remainder(cameraAngle - spriteAngle, 2 * PI);  // In [-PI, PI]
+        double centerX = (angleFromCenter + fov / 2.0) / fov * screenWidth;
+
+        // A wall of height 1 at distance d spans 2 * screenHeight / d rows (see Game::renderScreenByHeight)
+        double rowsPerUnit = 2.0 * screenHeight / distance;
+        double columnsPerUnit = screenWidth / (fov * distance);
+        double centerY = screenHeight / 2.0 - sprite.elevation * rowsPerUnit;
+        double radiusX = sprite.radius * columnsPerUnit;
+        double radiusY = sprite.radius * rowsPerUnit;
+        if (radiusX < 0.5 || radiusY < 0.5) continue;
+
+        int firstX = std::max(0, int(std::ceil(centerX - radiusX)));
+        int lastX = std::min(screenWidth - 1, int(std::floor(centerX + radiusX)));
+        int firstY = std::max(0, int(std::ceil(centerY - radiusY)));
+        int lastY = std::min(screenHeight - 1, int(std::floor(centerY + radiusY)));
+
+        for (int x = firstX; x <= lastX; ++x)
+        {
+            if (depthBuffer[x] < distance) continue;   // Behind a wall
+
+            double u = (x - centerX) / radiusX;
+            for (int y = firstY; y <= lastY; ++y)
+            {
+                double v = (y - centerY) / radiusY;
+                double q = u * u + v * v;       // Squared distance from the center, relative to the radius
+                if (q > 1.0) continue;
+
+                // The closer to the center, the brighter
+                Glyph tile;
+                if (q < 0.5 * 0.5)          tile = Glyphs::FULL_BLOCK;
+                else if (q < 0.75 * 0.75)   tile = Glyphs::DARK_SHADE;
+                else                        tile = Glyphs::LIGHT_SHADE;
+                screen[y * screenWidth + x] = tile;
+            }
+        }
+    }
+}
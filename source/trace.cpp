@@ -0,0 +1,78 @@
+/**
+ * @file trace.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Frame tracer implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "trace.hpp"
+#include <cstdio>
+
+void FrameTracer::enable(const std::string& path, std::size_t capacity)
+{
+    outputPath = path;
+    events.clear();
+    events.reserve(capacity);
+    droppedEvents = 0;
+    openEvents = 0;
+    droppedOpen = 0;
+    startTime = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+void FrameTracer::record(const char* name, char phase, std::int64_t value)
+{
+    // Never grow the buffer while the game is running. The ends of the recorded begins have their room kept,
+    // and the ends of the dropped ones are dropped: stages nest, so those are always the innermost
+    if (phase == 'E')
+    {
+        if (droppedOpen > 0)
+        {
+            droppedOpen--;
+            droppedEvents++;
+            return;
+        }
+        openEvents--;
+    }
+    else if (events.size() + openEvents + (phase == 'B' ? 2 : 1) > events.capacity())
+    {
+        if (phase == 'B') droppedOpen++;
+        droppedEvents++;
+        return;
+    }
+    else if (phase == 'B')
+    {
+        openEvents++;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now - startTime).count();
+    events.push_back({ name, phase, timestamp, value });
+}
+
+bool FrameTracer::flush() const
+{
+    if (!enabled) return false;
+
+    FILE* file = std::fopen(outputPath.c_str(), "w");
+    if (file == nullptr) return false;
+
+    // Source: https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        const Event& event = events[i];
+        std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%lld.%03lld,\"pid\":1,\"tid\":1",
+                     event.name, event.phase,
+                     (long long)(event.timestamp / 1000), (long long)(event.timestamp % 1000)); // Timestamps are in microseconds
+        if (event.phase == 'C') std::fprintf(file, ",\"args\":{\"value\":%lld}", (long long)event.value);
+        std::fprintf(file, "}%s\n", i + 1 < events.size() ? "," : "");
+    }
+    std::fprintf(file, "],\"otherData\":{\"droppedEvents\":%zu}}\n", droppedEvents);
+
+    std::fclose(file);
+    return true;
+}
@@ -0,0 +1,322 @@
+/**
+ * @file visibility.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief VisibilityTable class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "visibility.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+
+constexpr int SAMPLES = 3;                  // The points of a cell the sight is cast from: a grid of SAMPLES^2.
+constexpr double MAX_RAY_STEP = 0.3;        // The coarsest step of the rays (see RenderQuality).
+
+// A ray steps past a wall when the wall is thinner than its step, so its path only avoids the walls shrunk
+// by half a step. And anywhere in a cell is within half a diagonal of the grid's spacing from a point of the
+// grid, centered in the cell: the lines from there to a target stay that close to a line from the nearest point of the grid
+constexpr double TOLERANCE = MAX_RAY_STEP / 2 + 0.70710678 / SAMPLES;
+
+/**
+ * @return A number from 0 to 4 increasing with the angle of a direction, like atan2 but without the trigonometry.
+ */
+static double pseudoAngle(double dx, double dy)
+{
+    const double p = dy / (std::abs(dx) + std::abs(dy));
+    return dx >= 0 ? (dy >= 0 ? p : 4 + p) : 2 - p;
+}
+
+void VisibilityTable::sweep(double pointX, double pointY, int x, int y, std::uint64_t* cellBits, Scratch& scratch) const
+{
+    std::vector<std::pair<double, double>>& shadows = scratch.shadows;
+
+    // The directions a rectangle covers from its corners' directions, seen from the point outside it. Past 4
+    // when they wrap around 0
+    auto span = [](double a, double b, double c, double d) {
+        double low = std::min(std::min(a, b), std::min(c, d));
+        double high = std::max(std::max(a, b), std::max(c, d));
+        if (high - low > 2)     // Less than half a turn wide, so it crosses 0
+        {
+            low = 4;
+            high = 0;
+            for (double corner : { a, b, c, d })
+            {
+                low = std::min(low, corner < 2 ? corner + 4 : corner);
+                high = std::max(high, corner < 2 ? corner + 4 : corner);
+            }
+        }
+        return std::make_pair(low, high);
+    };
+    auto directions = [&](double x0, double y0, double x1, double y1) {
+        return span(pseudoAngle(x0 - pointX, y0 - pointY), pseudoAngle(x1 - pointX, y0 - pointY),
+                    pseudoAngle(x0 - pointX, y1 - pointY), pseudoAngle(x1 - pointX, y1 - pointY));
+    };
+
+    // The cells of the window share their corners, whose directions are computed once
+    const int corners = windowSize + 1;
+    std::vector<double>& cornerAngles = scratch.cornerAngles;
+    cornerAngles.resize(std::size_t(corners) * corners);
+    for (int row = 0; row < corners; ++row)
+    {
+        for (int column = 0; column < corners; ++column)
+        {
+            cornerAngles[row * corners + column] = pseudoAngle(x - radius + column - pointX, y - radius + row - pointY);
+        }
+    }
+
+    // The shadows are kept sorted and apart
+    auto addShadow = [&](double low, double high) {
+        auto first = std::lower_bound(shadows.begin(), shadows.end(), low, [](const auto& shadow, double value) { return shadow.second < value; });
+        if (first != shadows.end() && first->first <= low && first->second >= high) return;    // Already in the shade
+
+        auto last = first;
+        for (; last != shadows.end() && last->first <= high; ++last)
+        {
+            low = std::min(low, last->first);
+            high = std::max(high, last->second);
+        }
+        shadows.insert(shadows.erase(first, last), { low, high });
+    };
+    auto isShadowed = [&](double low, double high) {
+        auto shadow = std::lower_bound(shadows.begin(), shadows.end(), high, [](const auto& shadow, double value) { return shadow.second < value; });
+        return shadow != shadows.end() && shadow->first <= low;
+    };
+    auto castShadow = [&](double x0, double y0, double x1, double y1) {
+        const auto [low, high] = directions(x0, y0, x1, y1);
+        addShadow(low, std::min(high, 4.0));
+        if (high > 4) addShadow(0, high - 4);
+    };
+
+    // A line leaves the rings in order, and a cell it crosses is out of the shadows of the rings inside. So
+    // it enters a ring next to a cell of the ring before that wasn't shadowed ("open"), and goes on through
+    // open cells of the ring: the other cells of the ring are never looked at
+    const int stride = windowSize + 2;
+    const int neighbours[8] = { -stride - 1, -stride, -stride + 1, -1, 1, stride - 1, stride, stride + 1 };
+    const std::vector<std::uint8_t>& walls = scratch.walls;
+    std::vector<std::uint8_t>& state = scratch.state;
+    std::vector<int>& open = scratch.open;
+    std::vector<int>& nextOpen = scratch.nextOpen;
+    std::vector<int>& pending = scratch.pending;
+
+    shadows.clear();
+    state = rings;
+    open.assign(1, (radius + 1) * stride + radius + 1);
+    state[open[0]] = OPEN;
+    for (int ring = 1; ring <= radius; ++ring)
+    {
+        auto reachFrom = [&](int cell) {
+            for (int offset : neighbours)
+            {
+                if (state[cell + offset] != ring) continue;
+
+                state[cell + offset] = QUEUED;
+                pending.push_back(cell + offset);
+            }
+        };
+
+        nextOpen.clear();
+        for (int cell : open) reachFrom(cell);
+
+        while (!pending.empty())
+        {
+            const int cell = pending.back();
+            pending.pop_back();
+            const int dx = cell % stride - radius - 1;
+            const int dy = cell / stride - radius - 1;
+
+            // The point can be on the side of a neighbour, which is seen anyway. The walls of a ring are
+            // ignored by the cells of the same ring, which can only show more
+            if (ring > 1)
+            {
+                const double* corner = &cornerAngles[(dy + radius) * corners + (dx + radius)];
+                const auto [low, high] = span(corner[0], corner[1], corner[corners], corner[corners + 1]);
+                if (isShadowed(low, std::min(high, 4.0)) && (high <= 4 || isShadowed(0, high - 4))) continue;
+            }
+
+            state[cell] = OPEN;
+            nextOpen.push_back(cell);
+            reachFrom(cell);
+            if (walls[cell]) continue;
+
+            int bit = (dy + radius) * windowSize + (dx + radius);
+            cellBits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        }
+        if (nextOpen.empty()) break;    // Nothing else to see
+
+        // The wall shrunk by TOLERANCE, except towards the walls next to it: a bar across and a bar down the
+        // cell. A shadowed wall only hides what its shadow already does
+        for (int cell : nextOpen)
+        {
+            if (!walls[cell]) continue;
+
+            const int wallX = x + cell % stride - radius - 1;
+            const int wallY = y + cell / stride - radius - 1;
+            const double left = walls[cell - 1] ? 0.0 : TOLERANCE;
+            const double right = walls[cell + 1] ? 0.0 : TOLERANCE;
+            const double top = walls[cell - stride] ? 0.0 : TOLERANCE;
+            const double bottom = walls[cell + stride] ? 0.0 : TOLERANCE;
+            castShadow(wallX + left, wallY + TOLERANCE, wallX + 1 - right, wallY + 1 - TOLERANCE);
+            castShadow(wallX + TOLERANCE, wallY + top, wallX + 1 - TOLERANCE, wallY + 1 - bottom);
+        }
+
+        if (shadows.size() == 1 && shadows[0].first <= 0 && shadows[0].second >= 4) break;     // Nothing else to see
+        std::swap(open, nextOpen);
+    }
+}
+
+void VisibilityTable::computeCell(int x, int y, Scratch& scratch)
+{
+    const int cell = y * mapWidth + x;
+    if (map[cell] == '#') return;   // Nobody sees from inside a wall
+
+    std::uint64_t* cellBits = &bits[std::size_t(cell) * wordsPerCell];
+    int bit = radius * windowSize + radius;
+    cellBits[bit / 64] |= std::uint64_t(1) << (bit % 64);
+
+    // The walls of the window and of a cell around it, laid out like the rings
+    const int stride = windowSize + 2;
+    scratch.walls.resize(std::size_t(stride) * stride);
+    for (int row = 0; row < stride; ++row)
+    {
+        for (int column = 0; column < stride; ++column)
+        {
+            scratch.walls[row * stride + column] = isWall(x - radius - 1 + column, y - radius - 1 + row);
+        }
+    }
+
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        for (int j = 0; j < SAMPLES; ++j)
+        {
+            sweep(x + (i + 0.5) / SAMPLES, y + (j + 0.5) / SAMPLES, x, y, cellBits, scratch);
+        }
+    }
+}
+
+void VisibilityTable::build(const std::string& map, int mapWidth, int mapHeight, double renderDistance)
+{
+    this->map = map;
+    this->mapWidth = mapWidth;
+    this->mapHeight = mapHeight;
+    radius = int(std::ceil(renderDistance + MAX_RAY_STEP));   // The last step of a ray can end past the render distance
+    windowSize = 2 * radius + 1;
+    wordsPerCell = (windowSize * windowSize + 63) / 64;
+    bits.assign(std::size_t(mapWidth) * mapHeight * wordsPerCell, 0);
+
+    // The ring of each cell of the window, with a border of one cell outside all the rings. The cells whose
+    // closest points are out of the render distance are left in the border: a line reaching past them is out
+    // of it too
+    const int stride = windowSize + 2;
+    rings.assign(std::size_t(stride) * stride, BORDER);
+    for (int dy = -radius; dy <= radius; ++dy)
+    {
+        for (int dx = -radius; dx <= radius; ++dx)
+        {
+            int gapX = std::max(0, std::abs(dx) - 1);
+            int gapY = std::max(0, std::abs(dy) - 1);
+            if (gapX * gapX + gapY * gapY > radius * radius) continue;
+
+            rings[(dy + radius + 1) * stride + (dx + radius + 1)] = std::uint8_t(std::max(std::abs(dx), std::abs(dy)));
+        }
+    }
+
+    // The rows write apart in the bitsets
+    parallelFor(mapHeight, [&](int y) {
+        Scratch scratch;
+        for (int x = 0; x < mapWidth; ++x) computeCell(x, y, scratch);
+    });
+}
+
+std::shared_ptr<const VisibilityTable> VisibilityTable::share(const std::string& map, int mapWidth, int mapHeight, double renderDistance)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<const VisibilityTable>> tables;
+
+    std::string key = std::to_string(mapWidth) + 'x' + std::to_string(mapHeight) + '@' + std::to_string(renderDistance) + ':' + map;
+
+    // The lock is held while making the table, so games loading the same map at once share one
+    std::lock_guard<std::mutex> lock(mutex);
+    if (auto table = tables[key].lock()) return table;
+
+    for (auto it = tables.begin(); it != tables.end();)     // Forgets the released tables
+    {
+        if (it->second.expired())   it = tables.erase(it);
+        else                        ++it;
+    }
+
+    auto table = std::make_shared<VisibilityTable>();
+    table->build(map, mapWidth, mapHeight, renderDistance);
+    tables[key] = table;
+    return table;
+}
+
+void VisibilityOverlay::openCell(int x, int y)
+{
+    if (!table || table->bits.empty()) return;
+
+    const VisibilityTable& base = *table;
+    const int radius = base.radius;
+    for (int fromY = std::max(0, y - radius); fromY <= std::min(base.mapHeight - 1, y + radius); ++fromY)
+    {
+        for (int fromX = std::max(0, x - radius); fromX <= std::min(base.mapWidth - 1, x + radius); ++fromX)
+        {
+            // Nobody sees from a wall the edits never opened. Opening it marks its whole window
+            const int cell = fromY * base.mapWidth + fromX;
+            if (base.isWall(fromX, fromY) && (fromX != x || fromY != y) && !editedCells.count(cell)) continue;
+
+            auto [edited, added] = editedCells.try_emplace(cell);
+            if (added)
+            {
+                const std::uint64_t* shared = &base.bits[std::size_t(cell) * base.wordsPerCell];
+                edited->second.assign(shared, shared + base.wordsPerCell);
+            }
+            std::uint64_t* cellBits = edited->second.data();
+
+            // The targets in the window of both cells, one run of bits per row
+            const int firstX = std::max(0, std::max(x, fromX) - radius) - fromX + radius;
+            const int lastX = std::min(base.mapWidth - 1, std::min(x, fromX) + radius) - fromX + radius;
+            const int firstY = std::max(0, std::max(y, fromY) - radius) - fromY + radius;
+            const int lastY = std::min(base.mapHeight - 1, std::min(y, fromY) + radius) - fromY + radius;
+
+            for (int row = firstY; row <= lastY; ++row)
+            {
+                for (int bit = row * base.windowSize + firstX; bit <= row * base.windowSize + lastX;)
+                {
+                    // As many bits of the run as fit in the rest of the word
+                    const int count = std::min(64 - bit % 64, row * base.windowSize + lastX - bit + 1);
+                    const std::uint64_t mask = count == 64 ? ~std::uint64_t(0) : ((std::uint64_t(1) << count) - 1) << (bit % 64);
+                    cellBits[bit / 64] |= mask;
+                    bit += count;
+                }
+            }
+        }
+    }
+}
+
+bool VisibilityOverlay::isVisible(int fromX, int fromY, int toX, int toY) const
+{
+    if (!table) return true;
+
+    const VisibilityTable& base = *table;
+    if (!editedCells.empty() && fromX >= 0 && fromX < base.mapWidth && fromY >= 0 && fromY < base.mapHeight)
+    {
+        auto edited = editedCells.find(fromY * base.mapWidth + fromX);
+        if (edited != editedCells.end())
+        {
+            int dx = toX - fromX + base.radius;
+            int dy = toY - fromY + base.radius;
+            if (dx < 0 || dx >= base.windowSize || dy < 0 || dy >= base.windowSize) return false;
+
+            int bit = dy * base.windowSize + dx;
+            return edited->second[bit / 64] >> (bit % 64) & 1;
+        }
+    }
+    return base.isVisible(fromX, fromY, toX, toY);
+}
@@ -0,0 +1,150 @@
+/**
+ * @file wallTextures.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief WallTextures class implementation file.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "wallTextures.hpp"
+#include <algorithm>
+#include <string>
+
+// The textures row by row, drawn with the depths: ' ' is the face of the wall, then '.', ':' and '#'
+static constexpr const char* ART[int(WallTextures::Type::COUNT)][WallTextures::SIZE] = {
+    {   // BRICK
+        "::::::::::::::::",
+        "   :       :    ",
+        " . :    .  :  . ",
+        "   :       :    ",
+        "::::::::::::::::",
+        "       :       :",
+        "  .    :   .   :",
+        "       :       :",
+        "::::::::::::::::",
+        "   :       :    ",
+        "   :  .    :    ",
+        " . :       : .  ",
+        "::::::::::::::::",
+        "       :       :",
+        "   .   :       :",
+        "       :    .  :",
+    },
+    {   // DOOR
+        ".  :   :   :   .",
+        "   :   :   :    ",
+        "................",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "   :   :   : ## ",
+        "   :   :   : ## ",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "   :   :   :    ",
+        "................",
+        "   :   :   :    ",
+        ".  :   :   :   .",
+    },
+    {   // CRACKED
+        "                ",
+        "  .     #       ",
+        "       #     .  ",
+        "      ##        ",
+        "     #  #       ",
+        " .  #    #   .  ",
+        "   #      ##    ",
+        "  #         #   ",
+        "         .   #  ",
+        "   .          # ",
+        "        #       ",
+        "       # #   .  ",
+        "  .   #   #     ",
+        "     #     #    ",
+        "    #   .   #   ",
+        "                ",
+    },
+};
+
+static_assert([] {
+    for (const auto& texture : ART)
+    {
+        for (const char* row : texture)
+        {
+            if (std::char_traits<char>::length(row) != WallTextures::SIZE) return false;
+        }
+    }
+    return true;
+}(), "Every row of a texture must be SIZE characters long");
+
+WallTextures::WallTextures()
+{
+    auto depthOf = [](char c) -> std::uint8_t {
+        switch (c)
+        {
+            case '.':   return 1;
+            case ':':   return 2;
+            case '#':   return 3;
+            default:    return 0;
+        }
+    };
+
+    int offset = 0;
+    for (int type = 0; type < int(Type::COUNT); ++type)
+    {
+        for (int level = 0; level < LEVELS; ++level)
+        {
+            offsets[type][level] = offset;
+            offset += (SIZE >> level) * (SIZE >> level);
+        }
+    }
+    texels.resize(offset);
+
+    for (int type = 0; type < int(Type::COUNT); ++type)
+    {
+        std::uint8_t* base = &texels[offsets[type][0]];
+        for (int v = 0; v < SIZE; ++v)
+        {
+            const char* row = ART[type][v];
+            for (int u = 0; u < SIZE; ++u) base[u * SIZE + v] = depthOf(row[u]);
+        }
+
+        // Each level averages 2 x 2 texels of the previous one, rounded
+        for (int level = 1; level < LEVELS; ++level)
+        {
+            const int size = SIZE >> level;
+            const std::uint8_t* previous = &texels[offsets[type][level - 1]];
+            std::uint8_t* current = &texels[offsets[type][level]];
+            for (int u = 0; u < size; ++u)
+            {
+                for (int v = 0; v < size; ++v)
+                {
+                    const int sum = previous[(2 * u) * 2 * size + 2 * v] + previous[(2 * u) * 2 * size + 2 * v + 1] +
+                                    previous[(2 * u + 1) * 2 * size + 2 * v] + previous[(2 * u + 1) * 2 * size + 2 * v + 1];
+                    current[u * size + v] = std::uint8_t((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    // A deeper texel is some shades lighter, but never disappears: the walls have no holes
+    const Glyph ramp[SHADES] = { ' ', Glyphs::LIGHT_SHADE, Glyphs::MEDIUM_SHADE, Glyphs::DARK_SHADE, Glyphs::FULL_BLOCK };
+    for (int shade = 0; shade < SHADES; ++shade)
+    {
+        for (int depth = 0; depth < DEPTHS; ++depth)
+        {
+            shades[shade][depth] = shade == 0 ? ramp[0] : ramp[std::max(1, shade - depth)];
+        }
+    }
+}
+
+const std::uint8_t* WallTextures::getColumn(Type type, int level, double u) const
+{
+    const int size = SIZE >> level;
+    const int column = std::clamp(int(u * size), 0, size - 1);
+    return &texels[offsets[int(type)][level] + column * size];
+}
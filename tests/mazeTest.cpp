@@ -0,0 +1,96 @@
+/**
+ * @file mazeTest.cpp
+ * @author Felipe Passarela (felipepassarela11@gmail.com)
+ * @brief Checks that the generated mazes are closed and connected.
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+#include "maps.hpp"
+#include <cstdio>
+#include <vector>
+
+/**
+ * Floods a maze from the player's marker, moving in 4 directions, and checks that every empty cell is
+ * reached and that the border is all walls.
+ *
+ * @return False, after printing why, if the maze is open or split.
+ */
+static bool checkMaze(int width, int height, std::uint32_t seed, int corridorWidth)
+{
+    const MapData maze = Maps::generateMaze(width, height, seed, corridorWidth);
+    const int w = maze.width;
+    const int h = maze.height;
+
+    int holes = 0;
+    for (int x = 0; x < w; ++x) holes += (maze.tiles[x] != '#') + (maze.tiles[(h - 1) * w + x] != '#');
+    for (int y = 1; y < h - 1; ++y) holes += (maze.tiles[y * w] != '#') + (maze.tiles[y * w + w - 1] != '#');
+
+    int free = 0;
+    int start = -1;
+    for (int i = 0; i < w * h; ++i)
+    {
+        if (maze.tiles[i] == '#') continue;
+
+        free++;
+        if (maze.tiles[i] == '^') start = i;
+    }
+
+    int reached = 0;
+    if (start >= 0)
+    {
+        std::vector<bool> visited(maze.tiles.size(), false);
+        std::vector<int> queue = { start };
+        visited[start] = true;
+        for (std::size_t i = 0; i < queue.size(); ++i)
+        {
+            const int cell = queue[i];
+            const int x = cell % w;
+            const int y = cell / w;
+            const int neighbours[4] = { x > 0 ? cell - 1 : -1, x < w - 1 ? cell + 1 : -1, y > 0 ? cell - w : -1, y < h - 1 ? cell + w : -1 };
+            for (int neighbour : neighbours)
+            {
+                if (neighbour < 0 || visited[neighbour] || maze.tiles[neighbour] == '#') continue;
+
+                visited[neighbour] = true;
+                queue.push_back(neighbour);
+            }
+        }
+        reached = int(queue.size());
+    }
+
+    if (start >= 0 && holes == 0 && reached == free) return true;
+
+    std::printf("FAIL %dx%d seed %u corridor %d: %d holes, %d of %d free cells reached%s\n",
+        width, height, seed, corridorWidth, holes, reached, free, start < 0 ? ", no player marker" : "");
+    return false;
+}
+
+int main()
+{
+    // Thin mazes, one tile of rooms or a last column or row of tiles 1 room wide, and a few large ones
+    const int sizes[][2] = {
+        { 3, 3 }, { 6, 300 }, { 300, 6 }, { 11, 11 }, { 100, 300 }, { 170, 170 }, { 170, 40 },
+        { 161, 161 }, { 166, 321 }, { 200, 100 }, { 321, 166 }, { 300, 300 },
+    };
+    const int corridorWidths[] = { 1, 2, 4 };
+
+    int failures = 0;
+    int checked = 0;
+    for (const auto& size : sizes)
+    {
+        for (int corridorWidth : corridorWidths)
+        {
+            for (std::uint32_t seed = 1; seed <= 3; ++seed)
+            {
+                failures += !checkMaze(size[0], size[1], seed, corridorWidth);
+                checked++;
+            }
+        }
+    }
+
+    std::printf("%d of %d mazes closed and connected\n", checked - failures, checked);
+    return failures == 0 ? 0 : 1;
+}